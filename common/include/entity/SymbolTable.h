@@ -0,0 +1,44 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+using SymbolId = std::uint32_t;
+
+/**
+ * Interns input and output symbols to dense integer ids.
+ *
+ * Transitions and outputs are keyed by ids, names are looked up only for printing and visualization.
+ * The table is process-wide, so automata built by different converters (e.g. the two sides of a
+ * concatenation) agree on ids and can be merged without translation. It is shared by regex-to-mealy and
+ * regex-to-buchi and safe to use from several threads: lookups take a shared lock, interning a new
+ * symbol an exclusive one. Only symbols that end up in an automaton should be interned, the table never
+ * shrinks.
+ */
+class SymbolTable {
+public:
+    static constexpr SymbolId epsilon = 0;  // "\0", label of epsilon transitions
+    static constexpr SymbolId empty = 1;    // "", output of epsilon transitions
+    static constexpr SymbolId none = static_cast<SymbolId>(-1);
+
+    static SymbolId intern(const std::string& symbol);
+    // Id of an already interned symbol or none
+    static SymbolId find(const std::string& symbol);
+    // The reference stays valid for the lifetime of the process
+    static const std::string& getName(SymbolId id);
+    static std::size_t size();
+
+private:
+    SymbolTable();
+    static SymbolTable& instance();
+
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> names;  // deque keeps returned names valid while the table grows
+    std::unordered_map<std::string, SymbolId> ids;
+};
+
+#endif // SYMBOLTABLE_H
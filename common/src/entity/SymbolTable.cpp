@@ -0,0 +1,50 @@
+#include <entity/SymbolTable.h>
+#include <mutex>
+
+SymbolTable::SymbolTable() {
+    names = {std::string(1, '\0'), ""};
+    ids = {{names[epsilon], epsilon}, {names[empty], empty}};
+}
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(const std::string& symbol) {
+    SymbolTable& table = instance();
+    {
+        std::shared_lock lock(table.mutex);
+        auto it = table.ids.find(symbol);
+        if (it != table.ids.end()) {
+            return it->second;
+        }
+    }
+
+    // another thread may have interned the symbol between the two locks, emplace keeps its id
+    std::unique_lock lock(table.mutex);
+    auto [it, inserted] = table.ids.emplace(symbol, static_cast<SymbolId>(table.names.size()));
+    if (inserted) {
+        table.names.push_back(symbol);
+    }
+    return it->second;
+}
+
+SymbolId SymbolTable::find(const std::string& symbol) {
+    const SymbolTable& table = instance();
+    std::shared_lock lock(table.mutex);
+    auto it = table.ids.find(symbol);
+    return it == table.ids.end() ? none : it->second;
+}
+
+const std::string& SymbolTable::getName(SymbolId id) {
+    const SymbolTable& table = instance();
+    std::shared_lock lock(table.mutex);
+    return table.names.at(id);
+}
+
+std::size_t SymbolTable::size() {
+    const SymbolTable& table = instance();
+    std::shared_lock lock(table.mutex);
+    return table.names.size();
+}
@@ -0,0 +1,56 @@
+#ifndef ACCEPTANCELAYERS_H
+#define ACCEPTANCELAYERS_H
+
+#include <cstdint>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+
+/**
+ * Generalized Büchi acceptance of a frozen automaton read through a counter layer.
+ *
+ * With k acceptance sets, layer c < k waits for the c-th set. Leaving a state climbs over every following set
+ * that contains it, layer k is reached once all sets were passed and its states are the accepting ones, the next
+ * step starts over from layer 0. A run is accepting iff it passes layer k infinitely often.
+ * The sets are simplified and ordered first, to keep the reachable layered pairs few: a set that contains another
+ * set is implied by it and dropped, the rest are chained so that each set overlaps its predecessor the most, which
+ * lets a single step climb as many layers as possible. A classic condition, or sets that collapse into one,
+ * use a single layer, i.e. no counter at all.
+ */
+class AcceptanceLayers {
+public:
+    using StateId = FrozenTransitions::StateId;
+
+    static constexpr std::size_t maxSetCount = 32;
+
+    // Throws std::invalid_argument if the automaton has more than maxSetCount acceptance sets
+    AcceptanceLayers(const Automaton& automaton, const FrozenTransitions& frozen);
+
+    [[nodiscard]] std::uint32_t layerCount() const { return layers; }
+
+    [[nodiscard]] bool isAccepting(StateId state, std::uint32_t layer) const {
+        return layers == 1 ? membership[state] != 0 : layer + 1 == layers;
+    }
+
+    // Layer after leaving the state in the given layer
+    [[nodiscard]] std::uint32_t nextLayer(StateId state, std::uint32_t layer) const {
+        if (layers == 1) {
+            return 0;
+        }
+        std::uint32_t next = layer + 1 == layers ? 0 : layer;
+        while (next + 1 < layers && (membership[state] >> next & 1u) != 0) {
+            ++next;
+        }
+        return next;
+    }
+
+    // Acceptance sets of the automaton that remain after simplification, by index and in layer order
+    [[nodiscard]] const std::vector<std::size_t>& getOrder() const;
+
+private:
+    std::vector<std::uint32_t> membership;  // bit c is set iff the state is in the c-th set of the order
+    std::vector<std::size_t> order;
+    std::uint32_t layers;
+};
+
+#endif // ACCEPTANCELAYERS_H
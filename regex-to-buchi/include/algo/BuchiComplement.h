@@ -0,0 +1,79 @@
+#ifndef BUCHICOMPLEMENT_H
+#define BUCHICOMPLEMENT_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/StateTupleTable.h>
+
+/**
+ * Rank-based complement of a Büchi automaton (Kupferman, Vardi), built on the fly.
+ *
+ * A complement state is a level ranking f, mapping every state reached by the word so far to a rank in
+ * 0..2(n - |F|) with even ranks on final states, plus the breakpoint set O of even-ranked states whose paths still
+ * have to reach an odd rank. A successor ranking g may not rank a state above any of its predecessors, O restarts
+ * from all even-ranked states once it runs empty, and complement states with an empty O are accepting.
+ *
+ * Subsumption prunes the successors to the pointwise maximal rankings: every state takes the highest rank of the
+ * right parity under its bound, only a non-final state that would join O with an even bound may also drop to the
+ * odd rank below. No word is lost. For an accepting run of the full construction with rankings f, take the pruned
+ * run that drops to odd exactly where f ranks such a state below its bound; it stays pointwise above f. If one of
+ * its paths kept an even rank r forever, that path would pass final states only finitely often and from the next
+ * restart on it would be in O, where it keeps r only if f ranks it r as well. When O never runs empty again the
+ * restart is not needed: the states in O have all-even predecessors in O, so by König's lemma O holds such a path
+ * already. Either way f would keep a path at an even rank, which an accepting run does not. Only the rankings of
+ * the two runs are compared, so it does not matter where their O sets restart, e.g. O' empty while O is not.
+ *
+ * States are interned as flat tuples of ranks and O bits, successors are computed per (state, symbol) on first use.
+ * A generalized automaton is degeneralized first.
+ */
+class BuchiComplement {
+public:
+    using ComplementId = StateTupleTable::TupleId;
+
+    // Throws std::invalid_argument if the automaton has epsilon transitions
+    explicit BuchiComplement(const Automaton& automaton);
+
+    [[nodiscard]] ComplementId getInitialState() const;
+    // Complement states reached on the symbol, computed on first use. The reference stays valid
+    const std::vector<ComplementId>& successors(ComplementId state, SymbolId symbol);
+    [[nodiscard]] bool isAccepting(ComplementId state) const;
+
+    // Complement states generated so far
+    [[nodiscard]] std::size_t stateCount() const;
+
+    // Builds the part of the complement reachable over the given letters
+    [[nodiscard]] std::unique_ptr<Automaton> toAutomaton(const std::vector<std::string>& letters);
+
+private:
+    using StateId = FrozenTransitions::StateId;
+
+    static constexpr std::uint32_t unranked = static_cast<std::uint32_t>(-1);
+
+    // Frozen classic automaton to complement
+    struct Classic {
+        FrozenTransitions frozen;
+        std::vector<bool> finalStates;
+        std::vector<StateId> initialStates;
+    };
+
+    FrozenTransitions frozen;
+    std::vector<bool> finalStates;
+    std::vector<bool> productive;  // states that reach a cycle through a final state
+    std::size_t automatonStates;  // states of the complemented automaton, the ranks come first in a tuple
+    std::size_t obligationWords;  // 32-bit words of the O bits after the ranks
+
+    StateTupleTable rankings;
+    ComplementId initialState;
+    std::unordered_map<std::uint64_t, std::vector<ComplementId>> successorCache;  // keyed by state << 32 | symbol
+
+    explicit BuchiComplement(Classic classic);
+    [[nodiscard]] static Classic freezeClassic(const Automaton& automaton);
+    void findProductiveStates();
+    [[nodiscard]] bool hasObligations(const StateId* ranking) const;
+};
+
+#endif // BUCHICOMPLEMENT_H
@@ -0,0 +1,75 @@
+#ifndef BUCHIINTERSECTION_H
+#define BUCHIINTERSECTION_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/StateTupleTable.h>
+
+/**
+ * Intersection of two Büchi automata as an on-the-fly product.
+ *
+ * Product states are pairs (left, right) interned in a StateTupleTable. Only the initial pairs exist up front.
+ * The successors of a pair are computed by a merge of the two symbol-sorted CSR rows the first time they are
+ * asked for, so memory stays proportional to the part of the product a caller actually explores.
+ * Acceptance is the generalized Büchi condition made of the acceptance sets of both operands, the sets of the left
+ * operand come first: bit i of acceptance() is set for pairs whose component lies in the i-th set.
+ * toAutomaton() builds the reachable product as a generalized automaton with these sets, Degeneralizer turns it
+ * into a classic one as a separate step.
+ */
+class BuchiIntersection {
+public:
+    using TupleId = StateTupleTable::TupleId;
+    using Edge = FrozenTransitions::Edge;  // target is a TupleId
+    using EdgeRange = FrozenTransitions::EdgeRange;
+
+    static constexpr std::size_t maxSetCount = 32;  // bits of an acceptance mask
+
+    // Throws std::invalid_argument if an operand has epsilon transitions or the operands have more than
+    // maxSetCount acceptance sets together
+    BuchiIntersection(const Automaton& left, const Automaton& right);
+
+    [[nodiscard]] std::size_t getAcceptanceSetCount() const;
+
+    [[nodiscard]] const std::vector<TupleId>& getInitialStates() const;
+    // Edges of the product state, computed on first use. The range is valid until another state is expanded
+    EdgeRange successors(TupleId state);
+    // Bit i is set iff the state belongs to the i-th acceptance set
+    [[nodiscard]] std::uint32_t acceptance(TupleId state) const;
+
+    [[nodiscard]] const std::shared_ptr<State>& getLeftState(TupleId state) const;
+    [[nodiscard]] const std::shared_ptr<State>& getRightState(TupleId state) const;
+
+    // Product states discovered so far and how many of them were expanded
+    [[nodiscard]] std::size_t stateCount() const;
+    [[nodiscard]] std::size_t expandedStateCount() const;
+
+    // Explores the reachable product, the final states of the left operand give its final states
+    [[nodiscard]] std::unique_ptr<Automaton> toAutomaton();
+
+private:
+    static constexpr std::uint32_t unexpanded = static_cast<std::uint32_t>(-1);
+
+    FrozenTransitions left;
+    FrozenTransitions right;
+    std::vector<std::uint32_t> leftAcceptance;   // acceptance masks of the operand states
+    std::vector<std::uint32_t> rightAcceptance;
+    std::size_t leftSetCount;
+    std::size_t setCount;
+    std::vector<std::string> letters;  // common letters of the operands
+
+    StateTupleTable pairs;
+    std::vector<TupleId> initialStates;
+    std::vector<std::uint32_t> rowBegin;  // unexpanded for states whose successors are not computed yet
+    std::vector<std::uint32_t> rowEnd;
+    std::vector<Edge> edges;
+    std::size_t expanded;
+
+    TupleId addPair(FrozenTransitions::StateId leftState, FrozenTransitions::StateId rightState);
+    // Name of the product state, the elementary states of both components in a row
+    [[nodiscard]] std::vector<std::set<int>> getElementaryStates(TupleId state) const;
+};
+
+#endif // BUCHIINTERSECTION_H
@@ -0,0 +1,21 @@
+#ifndef DEGENERALIZER_H
+#define DEGENERALIZER_H
+
+#include <memory>
+#include <entity/Automaton.h>
+
+/**
+ * Degeneralization of a generalized Büchi automaton into a classic one.
+ *
+ * The result has a state for every reachable pair (state, layer) of the AcceptanceLayers counter, its final states
+ * are the pairs of the accepting layer. When the acceptance sets collapse into one set, the automaton keeps its
+ * states and only that set becomes final. EmptinessChecker and LassoMembership read generalized automata through
+ * the same layers without building them, so this is needed only where classic acceptance is required.
+ */
+class Degeneralizer {
+public:
+    // Output symbols are not carried over to the layered states
+    [[nodiscard]] static std::unique_ptr<Automaton> degeneralize(const Automaton& automaton);
+};
+
+#endif // DEGENERALIZER_H
@@ -0,0 +1,48 @@
+#ifndef EMPTINESSCHECKER_H
+#define EMPTINESSCHECKER_H
+
+#include <optional>
+#include <vector>
+#include <algo/AcceptanceLayers.h>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/Lasso.h>
+
+/**
+ * Emptiness check of a Büchi automaton by nested depth-first search (Courcoubetis, Vardi, Wolper, Yannakakis).
+ *
+ * The outer search walks the automaton from its initial states, every final state it leaves in postorder seeds
+ * an inner search that looks for a state still on the outer stack, which closes a cycle through that final state.
+ * Inner marks are shared by all seeds, so every state and edge is visited at most twice: O(states + transitions).
+ * Both searches run on the CSR layout with explicit stacks, the stacks give the lasso directly.
+ * A generalized automaton is searched through the AcceptanceLayers counter, whose nodes (state, layer) are never
+ * built as states, so the cost grows by the number of layers instead of a degeneralized copy.
+ */
+class EmptinessChecker {
+public:
+    // Throws std::invalid_argument if the automaton has epsilon transitions
+    explicit EmptinessChecker(const Automaton& automaton);
+
+    // Accepting lasso u·v^ω, i.e. a word of the language, nullopt if the language is empty
+    [[nodiscard]] std::optional<Lasso> findAcceptingLasso() const;
+    [[nodiscard]] bool isEmpty() const;
+
+private:
+    using StateId = FrozenTransitions::StateId;
+
+    struct Frame {
+        std::uint32_t node;                   // state * layerCount + layer
+        const FrozenTransitions::Edge* next;  // next edge of the state to follow
+        SymbolId entry;                       // symbol the node was entered with
+    };
+
+    FrozenTransitions frozen;
+    AcceptanceLayers layers;
+    std::vector<StateId> initialStates;
+
+    [[nodiscard]] Frame open(std::uint32_t node, SymbolId entry) const;
+    // Node entered by following the edge out of the node of the frame
+    [[nodiscard]] std::uint32_t successor(const Frame& frame, const FrozenTransitions::Edge& edge) const;
+};
+
+#endif // EMPTINESSCHECKER_H
@@ -0,0 +1,67 @@
+#ifndef INCLUSIONCHECKER_H
+#define INCLUSIONCHECKER_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <algo/BuchiComplement.h>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/Lasso.h>
+#include <entity/StateTupleTable.h>
+
+/**
+ * Language inclusion L(A) ⊆ L(B) of two Büchi automata, decided as emptiness of A × ¬B.
+ *
+ * The complement of B is the on-the-fly BuchiComplement and the product is explored lazily as well: a node
+ * (a, c, layer) is interned and its row of successors computed only when the nested depth-first search reaches it,
+ * so a counterexample is usually found long before the complement is complete. The layer counts the two acceptance
+ * conditions: 0 waits for a final state of A, 1 for an accepting complement state, 2 marks the accepting nodes.
+ * A generalized A is degeneralized first.
+ */
+class InclusionChecker {
+public:
+    // Throws std::invalid_argument if an automaton has epsilon transitions
+    InclusionChecker(const Automaton& included, const Automaton& including);
+
+    // Lasso u·v^ω accepted by the included automaton and rejected by the including one, nullopt if there is none.
+    // Throws std::length_error if a complement step has too many rank choices
+    [[nodiscard]] std::optional<Lasso> findCounterexample();
+    [[nodiscard]] bool isIncluded();
+
+    // Complement and product states generated so far
+    [[nodiscard]] std::size_t complementStateCount() const;
+    [[nodiscard]] std::size_t productStateCount() const;
+
+private:
+    using StateId = FrozenTransitions::StateId;
+    using NodeId = StateTupleTable::TupleId;
+
+    static constexpr std::uint32_t unexpanded = static_cast<std::uint32_t>(-1);
+
+    struct Frame {
+        NodeId node;
+        std::uint32_t next;  // index of the next edge of the node's row
+        std::uint32_t end;
+        SymbolId entry;      // symbol the node was entered with
+    };
+
+    FrozenTransitions included;
+    std::vector<bool> finalStates;
+    std::vector<StateId> initialStates;
+    BuchiComplement complement;
+
+    StateTupleTable nodes;  // (state of A, complement state, layer)
+    std::vector<std::uint32_t> rowBegin;  // unexpanded for nodes whose successors are not computed yet
+    std::vector<std::uint32_t> rowEnd;
+    std::vector<FrozenTransitions::Edge> edges;
+
+    InclusionChecker(const Automaton& classic, BuchiComplement complement);
+
+    NodeId addNode(StateId state, BuchiComplement::ComplementId complementState, std::uint32_t layer);
+    // Computes the row of the node on first use and opens a frame over it
+    Frame open(NodeId node, SymbolId entry);
+    [[nodiscard]] bool isAccepting(NodeId node) const;
+};
+
+#endif // INCLUSIONCHECKER_H
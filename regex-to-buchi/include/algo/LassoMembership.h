@@ -0,0 +1,67 @@
+#ifndef LASSOMEMBERSHIP_H
+#define LASSOMEMBERSHIP_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <algo/AcceptanceLayers.h>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/Lasso.h>
+
+/**
+ * Membership of ultimately periodic words u·v^ω in the language of one Büchi automaton.
+ *
+ * Successors are precomputed per symbol: table[symbol][state] is a contiguous range of target ids, so a step
+ * of the simulation is a single lookup. The prefix u is read over the set of states, then a nested
+ * depth-first search runs over the product of the automaton with the positions of v, whose node
+ * (state, i) means "in state before reading v[i]". The word is accepted iff a final state lies on
+ * a reachable cycle of that product, which costs O(|u| * transitions + |v| * (states + transitions)).
+ * Work buffers are sized once per batch and reused by every word.
+ * A generalized automaton adds the AcceptanceLayers counter to the product nodes.
+ */
+class LassoMembership {
+public:
+    // Throws std::invalid_argument if the automaton has epsilon transitions
+    explicit LassoMembership(const Automaton& automaton);
+
+    // Throws std::invalid_argument if the cycle is empty
+    [[nodiscard]] bool accepts(const Lasso& word) const;
+    [[nodiscard]] std::vector<bool> acceptsAll(const std::vector<Lasso>& words) const;
+
+private:
+    using StateId = FrozenTransitions::StateId;
+
+    struct Frame {
+        std::uint32_t node;
+        std::uint32_t next;  // index of the next successor of the node's state
+        std::uint32_t end;
+    };
+
+    // Buffers of one check, kept between the words of a batch
+    struct Workspace {
+        std::vector<bool> current;
+        std::vector<StateId> currentList;
+        std::vector<bool> next;
+        std::vector<StateId> nextList;
+        std::vector<std::uint8_t> colors;
+        std::vector<bool> red;
+        std::vector<Frame> outer;
+        std::vector<Frame> inner;
+    };
+
+    std::size_t stateCount;
+    std::vector<StateId> initialStates;
+    AcceptanceLayers layers;
+    std::vector<std::int32_t> columns;     // indexed by SymbolId, -1 for symbols without transitions
+    std::vector<std::uint32_t> offsets;    // row of (column, state) is column * (stateCount + 1) + state
+    std::vector<StateId> targets;
+
+    LassoMembership(const Automaton& automaton, const FrozenTransitions& frozen);
+
+    [[nodiscard]] bool accepts(const Lasso& word, Workspace& workspace) const;
+    // Successor range of the state on the symbol, empty for symbols the automaton does not know
+    [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> successors(StateId state, SymbolId symbol) const;
+};
+
+#endif // LASSOMEMBERSHIP_H
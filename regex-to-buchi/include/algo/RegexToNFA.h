@@ -4,6 +4,7 @@
 
 #include <string>
 #include <memory>
+#include <stdexcept>
 #include <set>
 #include <vector>
 #include <entity/Automaton.h>
@@ -16,8 +17,14 @@
 class RegexToNFA {
 private:
     std::string regex;
+    // Index of the next unread character, the parser never copies the rest of the pattern
+    std::size_t position;
     int stateCounter;
 
+    [[nodiscard]] bool atEnd() const;
+    [[nodiscard]] char peek() const;
+    [[nodiscard]] std::runtime_error parseError(const std::string& message) const;
+
     std::pair<std::string, std::string> parsePair();
     std::unique_ptr<Automaton> parseExpression();
     std::unique_ptr<Automaton> parseTerm();
@@ -25,14 +32,15 @@ private:
 
     std::shared_ptr<State> createState(bool isFinal = false);
     static void addTransition(TransitionsRelation::TransitionMap& transitions,
-                              const std::shared_ptr<State>& from, const std::string& symbol,
+                              const std::shared_ptr<State>& from, SymbolId symbol,
                               const std::shared_ptr<State>& to,
                               Automaton::OutputSymbolMap& outs,
-                              const std::string& out
+                              SymbolId out
                               );
 
-    std::pair<std::unique_ptr<Alphabet>, std::unique_ptr<Alphabet>>
-    mergeAlphabets(const std::unique_ptr<Automaton>& left, const std::unique_ptr<Automaton>& right);
+    static void mergeAlphabets(Automaton& into, const Automaton& from);
+    static void spliceTransitions(Automaton& into, Automaton& from);
+    static void spliceStates(Automaton& into, Automaton& from);
 
     std::unique_ptr<Automaton> handleElementaryLanguage(
         const std::string& input, const std::string& output
@@ -50,7 +58,7 @@ private:
     static void buildNewTransitions(
         const TransitionsRelation::TransitionMap& oldTransitions,
         TransitionsRelation::TransitionMap& newTransitions,
-        Automaton::OutputSymbolMap& oldOutFunction,
+        const Automaton::OutputSymbolMap& oldOutFunction,
         Automaton::OutputSymbolMap& newOutFunction,
         const std::vector<std::shared_ptr<State>>& states);
 
@@ -58,8 +66,6 @@ private:
         const std::shared_ptr<State>& initialState,
         const TransitionsRelation::TransitionMap& transitions);
 
-    bool hasState(std::vector<std::shared_ptr<State>> states, std::shared_ptr<State> state);
-
 public:
     explicit RegexToNFA(const std::string& regex);
 
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <entity/Alphabet.h>
+#include <entity/FrozenTransitions.h>
 #include <entity/State.h>
 #include <entity/TransitionsRelation.h>
 
@@ -14,8 +15,8 @@ class Automaton {
 public:
     // Define a type alias for the output symbols map
     using OutputSymbolMap = std::unordered_map<
-        std::pair<std::shared_ptr<State>, std::string>,
-        std::vector<std::string>,
+        TransitionsRelation::TransitionKey,
+        std::vector<SymbolId>,
         PairHash
     >;
     explicit Automaton();
@@ -24,7 +25,7 @@ public:
              std::vector<std::shared_ptr<State>> states,
              std::vector<std::shared_ptr<State>> finalStates,
              TransitionsRelation::TransitionMap transitionMap,
-             const OutputSymbolMap& outSymbolsMap = {},
+             OutputSymbolMap outSymbolsMap = {},
             std::unique_ptr<Alphabet> outAlphabet = nullptr
              );
     Automaton(const Automaton &other);
@@ -44,20 +45,26 @@ public:
     Alphabet* getOutputAlphabet() const;
     [[nodiscard]] const Alphabet* getOutAlphabet() const;
     OutputSymbolMap getOutputFunction() const;
+    OutputSymbolMap& _getOutputFunction();
 
 
     Alphabet* _getAlphabet() const;
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getInitialStates() const; /////
 //    [[nodiscard]] std::shared_ptr<State> getInitialStatesShared() const;
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getStates() const;
+    std::vector<std::shared_ptr<State>>& _getStates();
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getFinalStates() const;
+    // Generalized Büchi acceptance: a run is accepting iff it visits every acceptance set infinitely often.
+    // The final states are the first set, a classic automaton has no other
+    [[nodiscard]] std::size_t getAcceptanceSetCount() const;
+    [[nodiscard]] const std::vector<std::shared_ptr<State>>& getAcceptanceSet(std::size_t index) const;
+    [[nodiscard]] bool isGeneralized() const;
     [[nodiscard]] const TransitionsRelation* getTransitionsRelation() const;
 
     [[nodiscard]] const std::unordered_map<std::string, std::vector<std::string>> getAutomatonInText() const;
 
 
-    [[nodiscard]] const std::unordered_map<std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash>&
-    getOutSymbolsRelation() const;
+    [[nodiscard]] const OutputSymbolMap& getOutSymbolsRelation() const;
 
     TransitionsRelation* _getTransitionsRelation() const;
 
@@ -66,6 +73,7 @@ public:
     void setInitialStates(const std::vector<std::shared_ptr<State>>& newInitialStates); /////
     void setStates(const std::vector<std::shared_ptr<State>>& newStates);
     void setFinalStates(const std::vector<std::shared_ptr<State>>& newFinalStates);
+    void addAcceptanceSet(std::vector<std::shared_ptr<State>> acceptanceSet);
     void setTransitionsRelation(std::unique_ptr<TransitionsRelation> newTransitionsRelation);
     void setOutputFunction(const OutputSymbolMap& out);
 
@@ -73,9 +81,12 @@ public:
     [[nodiscard]] std::shared_ptr<State> findStateByElementaryState(const std::set<int>& elementaryState) const;
     [[nodiscard]] bool isDeterministic() const;
 
-    std::vector<std::string> getOutputOfTransition(const std::shared_ptr<State>& current, const std::string& input) const;
+    std::vector<SymbolId> getOutputOfTransition(const std::shared_ptr<State>& current, SymbolId input) const;
     std::unique_ptr<Automaton> clone() const;
 
+    // CSR layout of the transitions, initial states get the first ids and states follow in their order
+    [[nodiscard]] FrozenTransitions freeze() const;
+
 
 private:
     std::unique_ptr<Alphabet> alphabet;
@@ -84,6 +95,7 @@ private:
     std::vector<std::shared_ptr<State>> states;
     std::vector<std::shared_ptr<State>> initialStates;
     std::vector<std::shared_ptr<State>> finalStates;
+    std::vector<std::vector<std::shared_ptr<State>>> acceptanceSets;  // sets after the final states
 
     std::unique_ptr<TransitionsRelation> transitionsRelation;
     OutputSymbolMap outSymbolsRelation;
@@ -10,10 +10,7 @@
 
 struct VectorSetHash {
     std::size_t operator()(const std::vector<std::set<int>>& vecSet) const {
-        State stateFromVector{vecSet, false};
-
-        std::hash<State> stateHashFunction; // using State hash function, defined in State.cpp
-        return stateHashFunction(stateFromVector);
+        return State::hashElementaryStates(vecSet);
     }
 };
 
@@ -26,14 +23,10 @@ private:
     std::vector<std::shared_ptr<State>> finalStates;
     std::vector<std::string> alphabet;
     std::vector<std::string> outAlphabet;
-    std::unordered_map<
-        std::pair<std::shared_ptr<State>, std::string>, std::vector<std::shared_ptr<State>>, PairHash
-    > transitions;
+    TransitionsRelation::TransitionMap transitions;
     std::vector<std::shared_ptr<State>> initialStates;
 
-    std::unordered_map<
-        std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash
-    > outs;
+    Automaton::OutputSymbolMap outs;
 
 
 private:
@@ -0,0 +1,64 @@
+#ifndef FROZENTRANSITIONS_H
+#define FROZENTRANSITIONS_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <entity/State.h>
+#include <entity/SymbolTable.h>
+#include <entity/TransitionsRelation.h>
+
+/**
+ * Immutable compressed-sparse-row (CSR) layout of a transition relation.
+ *
+ * States get dense ids, edges of a state are stored contiguously between offsets[id] and offsets[id + 1],
+ * sorted by (symbol, target), so epsilon edges (symbol 0) open every row.
+ * Graph algorithms on Büchi automata work on ids and never touch the hashed transition map.
+ */
+class FrozenTransitions {
+public:
+    using StateId = std::uint32_t;
+
+    struct Edge {
+        SymbolId symbol;
+        StateId target;
+    };
+
+    // Half-open range of edges inside one row
+    class EdgeRange {
+    public:
+        EdgeRange(const Edge* first, const Edge* last) : first(first), last(last) {}
+
+        [[nodiscard]] const Edge* begin() const { return first; }
+        [[nodiscard]] const Edge* end() const { return last; }
+        [[nodiscard]] bool empty() const { return first == last; }
+        [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(last - first); }
+
+    private:
+        const Edge* first;
+        const Edge* last;
+    };
+
+    // Ids follow the order of the given states, states met only in transitions are appended
+    FrozenTransitions(const std::vector<std::shared_ptr<State>>& states,
+                      const TransitionsRelation::TransitionMap& transitions);
+
+    [[nodiscard]] std::size_t stateCount() const;
+    [[nodiscard]] std::size_t transitionCount() const;
+
+    [[nodiscard]] bool hasState(const State* state) const;
+    [[nodiscard]] StateId getId(const State* state) const;
+    [[nodiscard]] const std::shared_ptr<State>& getState(StateId id) const;
+
+    [[nodiscard]] EdgeRange edges(StateId state) const;
+    [[nodiscard]] EdgeRange move(StateId state, SymbolId input) const;
+
+private:
+    std::vector<std::shared_ptr<State>> states;
+    std::unordered_map<const State*, StateId> ids;
+    std::vector<std::uint32_t> offsets;
+    std::vector<Edge> transitions;
+};
+
+#endif // FROZENTRANSITIONS_H
@@ -0,0 +1,20 @@
+#ifndef LASSO_H
+#define LASSO_H
+
+#include <string>
+#include <vector>
+#include <entity/SymbolTable.h>
+
+/**
+ * Ultimately periodic word u·v^ω, the finite representative of an infinite word.
+ * The cycle is never empty for a lasso that stands for an ω-word.
+ */
+struct Lasso {
+    std::vector<SymbolId> prefix;
+    std::vector<SymbolId> cycle;
+
+    // Written in the regex syntax of this project, e.g. "xy(z)^"
+    [[nodiscard]] std::string toString() const;
+};
+
+#endif // LASSO_H
@@ -17,11 +17,14 @@ private:
     std::vector<std::set<int>> elementaryStates;
     bool final;
     std::string secondaryName;
+    std::size_t elementaryHash;      // structural hash of the elementary states, kept in sync by every setter
+    std::string name;                // display name, rebuilt by every setter that changes it
 
 
 private:
     [[nodiscard]] static std::string vectorToString(const std::vector<int>& elements, char delimiter);
     [[nodiscard]] static std::string setToString(const std::set<int>& elements, char delimiter);
+    [[nodiscard]] std::string buildName() const;
 
     
 public:
@@ -32,13 +35,18 @@ public:
     void setFinal(bool final = true);
     void setSecondaryName(const std::string &secondary_name);
 
-    [[nodiscard]] std::vector<std::set<int>> getElementaryStates() const;
+    [[nodiscard]] const std::vector<std::set<int>>& getElementaryStates() const;
     [[nodiscard]] bool isFinal() const;
-    [[nodiscard]] std::string getName() const; ///////
+    [[nodiscard]] const std::string& getName() const;
+    // Hash of the elementary states only, std::hash<State> adds the final flag
+    [[nodiscard]] std::size_t getHash() const;
     [[nodiscard]] bool isElementary() const;
     [[nodiscard]] std::string getSecondaryName() const;
 
     bool operator==(const State& other) const;
+
+    // Same value as getHash() of a state with these elementary states, without building one
+    [[nodiscard]] static std::size_t hashElementaryStates(const std::vector<std::set<int>>& elementaryStates);
 };
 
 namespace std {
@@ -0,0 +1,49 @@
+#ifndef STATETUPLETABLE_H
+#define STATETUPLETABLE_H
+
+#include <cstdint>
+#include <vector>
+#include <entity/FrozenTransitions.h>
+
+/**
+ * Interned tuples of state ids, the states of product constructions.
+ *
+ * All tuples of a table have the same arity and lie back to back in one flat array. A tuple is known by its
+ * dense TupleId, so two tuples of one table are equal iff their ids are. Lookup goes through an open-addressing
+ * hash table of ids, which needs neither node allocations nor an object per tuple.
+ */
+class StateTupleTable {
+public:
+    using StateId = FrozenTransitions::StateId;
+    using TupleId = std::uint32_t;
+
+    static constexpr TupleId none = static_cast<TupleId>(-1);
+
+    // Throws std::invalid_argument if the arity is 0
+    explicit StateTupleTable(std::size_t arity);
+
+    [[nodiscard]] std::size_t getArity() const;
+    [[nodiscard]] std::size_t size() const;
+
+    // Id of the tuple given by arity components, the tuple is added if it is new
+    TupleId intern(const StateId* components);
+    // Id of an already interned tuple or none
+    [[nodiscard]] TupleId find(const StateId* components) const;
+
+    // Components of an interned tuple, valid until the next tuple is added
+    [[nodiscard]] const StateId* get(TupleId id) const;
+    [[nodiscard]] StateId get(TupleId id, std::size_t position) const;
+
+private:
+    std::size_t arity;
+    std::vector<StateId> components;
+    std::vector<std::uint32_t> hashes;  // hash of every tuple, reused when the slots grow
+    std::vector<TupleId> slots;         // linear probing, the capacity is a power of two
+
+    [[nodiscard]] std::uint32_t hash(const StateId* tuple) const;
+    // Slot holding the tuple, or the empty slot where it belongs
+    [[nodiscard]] std::size_t findSlot(const StateId* tuple, std::uint32_t tupleHash) const;
+    void grow();
+};
+
+#endif // STATETUPLETABLE_H
@@ -2,6 +2,7 @@
 #define TRANSITION_H
 
 #include <entity/State.h>
+#include <entity/SymbolTable.h>
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -14,20 +15,22 @@ struct PairHash {
 
 class TransitionsRelation {
 public:
-    using TransitionKey = std::pair<std::shared_ptr<State>, std::string>;
+    using TransitionKey = std::pair<std::shared_ptr<State>, SymbolId>;
     using TransitionMap = std::unordered_map<TransitionKey, std::vector<std::shared_ptr<State>>, PairHash>;
 
     explicit TransitionsRelation(TransitionMap transitions);
 
     std::vector<std::shared_ptr<State>> move(
         const std::shared_ptr<State>& current,
-        const std::string& input) const;
+        SymbolId input) const;
 
     [[nodiscard]] const TransitionMap& getTransitions() const;
+    // Mutable access, lets constructions splice the map instead of copying it
+    TransitionMap& _getTransitions();
 
     void addTransition(
         const std::shared_ptr<State>& startState,
-        const std::string& input,
+        SymbolId input,
         const std::shared_ptr<State>& endState
     );
     void setTransitions(const TransitionMap& pairs);
@@ -10,11 +10,23 @@ class ExamplesHelper
 {
 public:
     static void processExamples();
+    // Accepting lasso of every concatenation example
+    static void emptinessExamples();
+    // Emptiness witnesses of all examples checked against every example in one batch
+    static void membershipExamples();
+    // Products of concatenation results, degeneralized and checked for emptiness
+    static void intersectionExamples();
+    // Automata with several acceptance sets, checked directly and degeneralized
+    static void generalizedExamples();
+    // Language inclusion through the on-the-fly complement, with counterexamples
+    static void inclusionExamples();
 private:
+    static std::vector<std::vector<std::string>> concatenationExamples();
     static std::vector<std::string> example1();
     static std::vector<std::string> example2();
     static std::vector<std::string> example3();
     static std::vector<std::string> example4();
+    static std::vector<std::string> example5();
 };
 
 #endif //CONCATENATIONEXAMPLES_H
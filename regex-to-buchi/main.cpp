@@ -4,5 +4,10 @@
 int main()
 {
     ExamplesHelper::processExamples();
+    ExamplesHelper::emptinessExamples();
+    ExamplesHelper::membershipExamples();
+    ExamplesHelper::intersectionExamples();
+    ExamplesHelper::generalizedExamples();
+    ExamplesHelper::inclusionExamples();
     return 0;
 }
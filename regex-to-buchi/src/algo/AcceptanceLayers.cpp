@@ -0,0 +1,85 @@
+#include <algo/AcceptanceLayers.h>
+#include <stdexcept>
+
+AcceptanceLayers::AcceptanceLayers(const Automaton& automaton, const FrozenTransitions& frozen) {
+    const std::size_t setCount = automaton.getAcceptanceSetCount();
+    if (setCount > maxSetCount) {
+        throw std::invalid_argument("Automaton has more than " + std::to_string(maxSetCount) + " acceptance sets");
+    }
+
+    std::vector<std::vector<bool>> sets(setCount, std::vector<bool>(frozen.stateCount(), false));
+    std::vector<std::size_t> sizes(setCount, 0);
+    for (std::size_t i = 0; i < setCount; ++i) {
+        for (const auto& state : automaton.getAcceptanceSet(i)) {
+            const StateId id = frozen.getId(state.get());
+            if (!sets[i][id]) {
+                sets[i][id] = true;
+                ++sizes[i];
+            }
+        }
+    }
+
+    // a set that contains another set is implied by it, of equal sets the first one stays
+    auto contains = [&sets](std::size_t outer, std::size_t inner) {
+        for (std::size_t state = 0; state < sets[inner].size(); ++state) {
+            if (sets[inner][state] && !sets[outer][state]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    std::vector<std::size_t> remaining;
+    for (std::size_t i = 0; i < setCount; ++i) {
+        bool implied = false;
+        for (std::size_t j = 0; j < setCount && !implied; ++j) {
+            implied = j != i && (sizes[j] < sizes[i] || (sizes[j] == sizes[i] && j < i)) && contains(i, j);
+        }
+        if (!implied) {
+            remaining.push_back(i);
+        }
+    }
+
+    // chain the sets, the largest first and then always the one sharing the most states with the previous
+    auto overlap = [&sets](std::size_t left, std::size_t right) {
+        std::size_t common = 0;
+        for (std::size_t state = 0; state < sets[left].size(); ++state) {
+            common += sets[left][state] && sets[right][state];
+        }
+        return common;
+    };
+    while (!remaining.empty()) {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < remaining.size(); ++i) {
+            const std::size_t candidate = remaining[i];
+            const std::size_t current = remaining[best];
+            if (order.empty()) {
+                if (sizes[candidate] > sizes[current]) {
+                    best = i;
+                }
+                continue;
+            }
+            const std::size_t candidateOverlap = overlap(order.back(), candidate);
+            const std::size_t currentOverlap = overlap(order.back(), current);
+            if (candidateOverlap > currentOverlap ||
+                (candidateOverlap == currentOverlap && sizes[candidate] > sizes[current])) {
+                best = i;
+            }
+        }
+        order.push_back(remaining[best]);
+        remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(best));
+    }
+
+    membership.assign(frozen.stateCount(), 0);
+    for (std::size_t layer = 0; layer < order.size(); ++layer) {
+        for (std::size_t state = 0; state < membership.size(); ++state) {
+            if (sets[order[layer]][state]) {
+                membership[state] |= 1u << layer;
+            }
+        }
+    }
+    layers = order.size() == 1 ? 1 : static_cast<std::uint32_t>(order.size() + 1);
+}
+
+const std::vector<std::size_t>& AcceptanceLayers::getOrder() const {
+    return order;
+}
@@ -0,0 +1,240 @@
+#include <algo/BuchiComplement.h>
+#include <algo/Degeneralizer.h>
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+BuchiComplement::BuchiComplement(const Automaton& automaton)
+    : BuchiComplement(freezeClassic(automaton)) {}
+
+BuchiComplement::BuchiComplement(Classic classic)
+    : frozen(std::move(classic.frozen)),
+      finalStates(std::move(classic.finalStates)),
+      automatonStates(frozen.stateCount()),
+      obligationWords(automatonStates / 32 + 1),
+      rankings(automatonStates + obligationWords) {
+    for (StateId state = 0; state < automatonStates; ++state) {
+        const auto row = frozen.edges(state);
+        // epsilon edges open every row
+        if (!row.empty() && row.begin()->symbol == SymbolTable::epsilon) {
+            throw std::invalid_argument("Complementation expects an automaton without epsilon transitions");
+        }
+    }
+
+    findProductiveStates();
+
+    // ranks never exceed 2(n - |F|) (Gurumurthy, Kupferman, Somenzi, Vardi), the initial states start there
+    const auto finalCount = static_cast<std::size_t>(std::count(finalStates.begin(), finalStates.end(), true));
+    std::vector<StateId> initial(automatonStates + obligationWords, 0);
+    std::fill(initial.begin(), initial.begin() + static_cast<std::ptrdiff_t>(automatonStates), unranked);
+    for (StateId state : classic.initialStates) {
+        if (productive[state]) {
+            initial[state] = static_cast<std::uint32_t>(2 * (automatonStates - finalCount));
+        }
+    }
+    initialState = rankings.intern(initial.data());
+}
+
+BuchiComplement::Classic BuchiComplement::freezeClassic(const Automaton& automaton) {
+    std::unique_ptr<Automaton> degeneralized;
+    const Automaton* classic = &automaton;
+    if (automaton.isGeneralized()) {
+        degeneralized = Degeneralizer::degeneralize(automaton);
+        classic = degeneralized.get();
+    }
+
+    Classic result{classic->freeze(), {}, {}};
+    result.finalStates.assign(result.frozen.stateCount(), false);
+    for (const auto& state : classic->getFinalStates()) {
+        result.finalStates[result.frozen.getId(state.get())] = true;
+    }
+    for (const auto& state : classic->getInitialStates()) {
+        result.initialStates.push_back(result.frozen.getId(state.get()));
+    }
+    return result;
+}
+
+BuchiComplement::ComplementId BuchiComplement::getInitialState() const {
+    return initialState;
+}
+
+const std::vector<BuchiComplement::ComplementId>& BuchiComplement::successors(ComplementId state, SymbolId symbol) {
+    const std::uint64_t key = static_cast<std::uint64_t>(state) << 32 | symbol;
+    auto cached = successorCache.find(key);
+    if (cached != successorCache.end()) {
+        return cached->second;
+    }
+
+    // interning may move the tuples, so the ranking is copied
+    const StateId* source = rankings.get(state);
+    const std::vector<StateId> ranking(source, source + automatonStates + obligationWords);
+    const StateId* obligations = ranking.data() + automatonStates;
+    const bool restart = !hasObligations(ranking.data());
+
+    // bound of every successor is the lowest rank of its predecessors, O moves along the edges
+    std::vector<std::uint32_t> bound(automatonStates, unranked);
+    std::vector<bool> obliged(automatonStates, false);
+    for (StateId from = 0; from < automatonStates; ++from) {
+        if (ranking[from] == unranked) {
+            continue;
+        }
+        const bool fromObligation = (obligations[from / 32] >> (from % 32) & 1u) != 0;
+        for (const auto& edge : frozen.move(from, symbol)) {
+            if (!productive[edge.target]) {
+                continue;
+            }
+            bound[edge.target] = std::min(bound[edge.target], ranking[from]);
+            obliged[edge.target] = obliged[edge.target] || fromObligation;
+        }
+    }
+
+    // the highest rank of the right parity, a state that would join O with an even bound may also drop to odd
+    std::vector<StateId> next(automatonStates + obligationWords, 0);
+    StateId* nextObligations = next.data() + automatonStates;
+    std::vector<StateId> choices;
+    for (StateId target = 0; target < automatonStates; ++target) {
+        std::uint32_t rank = bound[target];
+        if (rank != unranked && finalStates[target] && rank % 2 == 1) {
+            --rank;
+        }
+        next[target] = rank;
+        if (rank == unranked || rank % 2 == 1 || !(restart || obliged[target])) {
+            continue;
+        }
+        nextObligations[target / 32] |= 1u << (target % 32);
+        if (!finalStates[target] && rank > 0) {
+            choices.push_back(target);
+        }
+    }
+    if (choices.size() >= 64) {
+        throw std::length_error("Too many rank choices for one complement step");
+    }
+
+    std::vector<ComplementId> targets;
+    std::vector<StateId> choice;
+    for (std::uint64_t mask = 0; mask < (std::uint64_t{1} << choices.size()); ++mask) {
+        choice = next;
+        for (std::size_t i = 0; i < choices.size(); ++i) {
+            if (mask >> i & 1u) {
+                const StateId target = choices[i];
+                --choice[target];
+                choice[automatonStates + target / 32] &= ~(1u << (target % 32));
+            }
+        }
+        targets.push_back(rankings.intern(choice.data()));
+    }
+
+    // references to the values of an unordered_map survive rehashing
+    return successorCache.emplace(key, std::move(targets)).first->second;
+}
+
+/**
+ * A state is productive if it reaches a cycle through a final state. Runs through other states are never accepting,
+ * so they are left out of the rankings.
+ */
+void BuchiComplement::findProductiveStates() {
+    std::vector<std::vector<StateId>> predecessors(automatonStates);
+    for (StateId state = 0; state < automatonStates; ++state) {
+        for (const auto& edge : frozen.edges(state)) {
+            predecessors[edge.target].push_back(state);
+        }
+    }
+
+    // final states on a cycle are found backwards from their predecessors, then everything reaching them
+    productive.assign(automatonStates, false);
+    std::vector<StateId> stack;
+    std::vector<bool> seen(automatonStates, false);
+    for (StateId final = 0; final < automatonStates; ++final) {
+        if (!finalStates[final] || productive[final]) {
+            continue;
+        }
+        std::fill(seen.begin(), seen.end(), false);
+        stack.assign(predecessors[final].begin(), predecessors[final].end());
+        while (!stack.empty() && !seen[final]) {
+            const StateId state = stack.back();
+            stack.pop_back();
+            if (!seen[state]) {
+                seen[state] = true;
+                stack.insert(stack.end(), predecessors[state].begin(), predecessors[state].end());
+            }
+        }
+        if (seen[final]) {
+            productive[final] = true;
+        }
+    }
+
+    for (StateId state = 0; state < automatonStates; ++state) {
+        if (productive[state]) {
+            stack.push_back(state);
+        }
+    }
+    while (!stack.empty()) {
+        const StateId state = stack.back();
+        stack.pop_back();
+        for (StateId predecessor : predecessors[state]) {
+            if (!productive[predecessor]) {
+                productive[predecessor] = true;
+                stack.push_back(predecessor);
+            }
+        }
+    }
+}
+
+bool BuchiComplement::isAccepting(ComplementId state) const {
+    return !hasObligations(rankings.get(state));
+}
+
+std::size_t BuchiComplement::stateCount() const {
+    return rankings.size();
+}
+
+bool BuchiComplement::hasObligations(const StateId* ranking) const {
+    const StateId* obligations = ranking + automatonStates;
+    return std::any_of(obligations, obligations + obligationWords, [](StateId word) { return word != 0; });
+}
+
+std::unique_ptr<Automaton> BuchiComplement::toAutomaton(const std::vector<std::string>& letters) {
+    std::vector<SymbolId> symbols;
+    for (const std::string& letter : letters) {
+        symbols.push_back(SymbolTable::intern(letter));
+    }
+
+    std::vector<std::shared_ptr<State>> states;
+    std::vector<bool> visited;
+    std::deque<ComplementId> queue;
+    auto visit = [&](ComplementId state) {
+        if (visited.size() <= state) {
+            visited.resize(state + 1, false);
+            states.resize(state + 1);
+        }
+        if (!visited[state]) {
+            visited[state] = true;
+            states[state] = std::make_shared<State>(std::vector<std::set<int>>{{static_cast<int>(state)}},
+                                                    isAccepting(state));
+            queue.push_back(state);
+        }
+        return states[state];
+    };
+
+    const std::vector<std::shared_ptr<State>> initial{visit(initialState)};
+    std::vector<std::shared_ptr<State>> reachable;
+    std::vector<std::shared_ptr<State>> accepting;
+    TransitionsRelation::TransitionMap transitions;
+    while (!queue.empty()) {
+        const ComplementId state = queue.front();
+        queue.pop_front();
+        reachable.push_back(states[state]);
+        if (isAccepting(state)) {
+            accepting.push_back(states[state]);
+        }
+        for (SymbolId symbol : symbols) {
+            for (ComplementId target : successors(state, symbol)) {
+                transitions[{states[state], symbol}].push_back(visit(target));
+            }
+        }
+    }
+
+    return std::make_unique<Automaton>(
+        std::make_unique<Alphabet>(letters), initial, reachable, accepting, std::move(transitions),
+        Automaton::OutputSymbolMap{}, std::make_unique<Alphabet>(std::vector<std::string>{}));
+}
@@ -0,0 +1,175 @@
+#include <algo/BuchiIntersection.h>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace {
+    void requireNoEpsilon(const FrozenTransitions& frozen) {
+        for (FrozenTransitions::StateId state = 0; state < frozen.stateCount(); ++state) {
+            const auto row = frozen.edges(state);
+            // epsilon edges open every row
+            if (!row.empty() && row.begin()->symbol == SymbolTable::epsilon) {
+                throw std::invalid_argument("Intersection expects automata without epsilon transitions");
+            }
+        }
+    }
+
+    // Bit i of a state is set iff it lies in the i-th acceptance set of the automaton
+    std::vector<std::uint32_t> acceptanceMasks(const Automaton& automaton, const FrozenTransitions& frozen) {
+        std::vector<std::uint32_t> masks(frozen.stateCount(), 0);
+        for (std::size_t i = 0; i < automaton.getAcceptanceSetCount(); ++i) {
+            for (const auto& state : automaton.getAcceptanceSet(i)) {
+                masks[frozen.getId(state.get())] |= 1u << i;
+            }
+        }
+        return masks;
+    }
+}
+
+BuchiIntersection::BuchiIntersection(const Automaton& left, const Automaton& right)
+    : left(left.freeze()), right(right.freeze()),
+      leftSetCount(left.getAcceptanceSetCount()),
+      setCount(left.getAcceptanceSetCount() + right.getAcceptanceSetCount()),
+      pairs(2), expanded(0) {
+    requireNoEpsilon(this->left);
+    requireNoEpsilon(this->right);
+    if (setCount > maxSetCount) {
+        throw std::invalid_argument("Intersection has more than " + std::to_string(maxSetCount) + " acceptance sets");
+    }
+    leftAcceptance = acceptanceMasks(left, this->left);
+    rightAcceptance = acceptanceMasks(right, this->right);
+
+    const std::vector<std::string> rightLetters = right.getAlphabet()->getLetters();
+    for (const std::string& letter : left.getAlphabet()->getLetters()) {
+        if (std::find(rightLetters.begin(), rightLetters.end(), letter) != rightLetters.end()) {
+            letters.push_back(letter);
+        }
+    }
+
+    for (const auto& leftState : left.getInitialStates()) {
+        for (const auto& rightState : right.getInitialStates()) {
+            const TupleId state = addPair(this->left.getId(leftState.get()), this->right.getId(rightState.get()));
+            if (std::find(initialStates.begin(), initialStates.end(), state) == initialStates.end()) {
+                initialStates.push_back(state);
+            }
+        }
+    }
+}
+
+std::size_t BuchiIntersection::getAcceptanceSetCount() const {
+    return setCount;
+}
+
+const std::vector<BuchiIntersection::TupleId>& BuchiIntersection::getInitialStates() const {
+    return initialStates;
+}
+
+BuchiIntersection::EdgeRange BuchiIntersection::successors(TupleId state) {
+    if (rowBegin[state] == unexpanded) {
+        // both rows are sorted by symbol, walk them together and pair up the targets of every common symbol
+        const auto leftRow = left.edges(pairs.get(state, 0));
+        const auto rightRow = right.edges(pairs.get(state, 1));
+        const auto begin = static_cast<std::uint32_t>(edges.size());
+        const Edge* l = leftRow.begin();
+        const Edge* r = rightRow.begin();
+        while (l != leftRow.end() && r != rightRow.end()) {
+            if (l->symbol < r->symbol) {
+                ++l;
+            } else if (r->symbol < l->symbol) {
+                ++r;
+            } else {
+                const SymbolId symbol = l->symbol;
+                const Edge* rightFirst = r;
+                for (; l != leftRow.end() && l->symbol == symbol; ++l) {
+                    for (r = rightFirst; r != rightRow.end() && r->symbol == symbol; ++r) {
+                        edges.push_back(Edge{symbol, addPair(l->target, r->target)});
+                    }
+                }
+            }
+        }
+        // addPair grows the row vectors, so the row of the state is written only now
+        rowBegin[state] = begin;
+        rowEnd[state] = static_cast<std::uint32_t>(edges.size());
+        ++expanded;
+    }
+
+    const Edge* data = edges.data();
+    return {data + rowBegin[state], data + rowEnd[state]};
+}
+
+std::uint32_t BuchiIntersection::acceptance(TupleId state) const {
+    return leftAcceptance[pairs.get(state, 0)] | rightAcceptance[pairs.get(state, 1)] << leftSetCount;
+}
+
+const std::shared_ptr<State>& BuchiIntersection::getLeftState(TupleId state) const {
+    return left.getState(pairs.get(state, 0));
+}
+
+const std::shared_ptr<State>& BuchiIntersection::getRightState(TupleId state) const {
+    return right.getState(pairs.get(state, 1));
+}
+
+std::size_t BuchiIntersection::stateCount() const {
+    return pairs.size();
+}
+
+std::size_t BuchiIntersection::expandedStateCount() const {
+    return expanded;
+}
+
+std::unique_ptr<Automaton> BuchiIntersection::toAutomaton() {
+    // pairs are only discovered from initial or expanded pairs, so expanding them in id order closes the product
+    for (TupleId state = 0; state < pairs.size(); ++state) {
+        successors(state);
+    }
+
+    std::vector<std::shared_ptr<State>> states;
+    std::vector<std::vector<std::shared_ptr<State>>> acceptanceSets(setCount);
+    for (TupleId state = 0; state < pairs.size(); ++state) {
+        const std::uint32_t mask = acceptance(state);
+        states.push_back(std::make_shared<State>(getElementaryStates(state), (mask & 1u) != 0));
+        for (std::size_t i = 0; i < setCount; ++i) {
+            if (mask >> i & 1u) {
+                acceptanceSets[i].push_back(states.back());
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<State>> initial;
+    for (TupleId state : initialStates) {
+        initial.push_back(states[state]);
+    }
+
+    TransitionsRelation::TransitionMap transitions;
+    for (TupleId state = 0; state < pairs.size(); ++state) {
+        for (const Edge& edge : successors(state)) {
+            transitions[{states[state], edge.symbol}].push_back(states[edge.target]);
+        }
+    }
+
+    auto product = std::make_unique<Automaton>(
+        std::make_unique<Alphabet>(letters), initial, states, acceptanceSets[0], std::move(transitions),
+        Automaton::OutputSymbolMap{}, std::make_unique<Alphabet>(std::vector<std::string>{}));
+    for (std::size_t i = 1; i < setCount; ++i) {
+        product->addAcceptanceSet(std::move(acceptanceSets[i]));
+    }
+    return product;
+}
+
+BuchiIntersection::TupleId BuchiIntersection::addPair(FrozenTransitions::StateId leftState,
+                                                      FrozenTransitions::StateId rightState) {
+    const std::array<StateTupleTable::StateId, 2> key{leftState, rightState};
+    const TupleId state = pairs.intern(key.data());
+    if (state == rowBegin.size()) {
+        rowBegin.push_back(unexpanded);
+        rowEnd.push_back(unexpanded);
+    }
+    return state;
+}
+
+std::vector<std::set<int>> BuchiIntersection::getElementaryStates(TupleId state) const {
+    std::vector<std::set<int>> elementaryStates = getLeftState(state)->getElementaryStates();
+    const auto& rightStates = getRightState(state)->getElementaryStates();
+    elementaryStates.insert(elementaryStates.end(), rightStates.begin(), rightStates.end());
+    return elementaryStates;
+}
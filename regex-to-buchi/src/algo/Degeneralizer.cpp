@@ -0,0 +1,66 @@
+#include <algo/Degeneralizer.h>
+#include <algo/AcceptanceLayers.h>
+#include <entity/StateTupleTable.h>
+#include <algorithm>
+#include <array>
+#include <deque>
+
+std::unique_ptr<Automaton> Degeneralizer::degeneralize(const Automaton& automaton) {
+    const FrozenTransitions frozen = automaton.freeze();
+    const AcceptanceLayers layers(automaton, frozen);
+    auto alphabet = std::make_unique<Alphabet>(*automaton.getAlphabet());
+    auto outAlphabet = std::make_unique<Alphabet>(
+        automaton.getOutAlphabet() ? automaton.getOutAlphabet()->getLetters() : std::vector<std::string>{});
+
+    if (layers.layerCount() == 1) {
+        return std::make_unique<Automaton>(
+            std::move(alphabet), automaton.getInitialStates(), automaton.getStates(),
+            automaton.getAcceptanceSet(layers.getOrder()[0]), automaton.getTransitionsRelation()->getTransitions(),
+            automaton.getOutSymbolsRelation(), std::move(outAlphabet));
+    }
+
+    StateTupleTable pairs(2);  // (state, layer)
+    std::vector<std::shared_ptr<State>> states;
+    std::vector<std::shared_ptr<State>> finalStates;
+    std::deque<StateTupleTable::TupleId> queue;
+    auto addState = [&](FrozenTransitions::StateId state, std::uint32_t layer) {
+        const std::array<StateTupleTable::StateId, 2> key{state, layer};
+        const std::size_t before = pairs.size();
+        const StateTupleTable::TupleId id = pairs.intern(key.data());
+        if (pairs.size() != before) {
+            std::vector<std::set<int>> name = frozen.getState(state)->getElementaryStates();
+            name.push_back({static_cast<int>(layer)});
+            const bool final = layers.isAccepting(state, layer);
+            states.push_back(std::make_shared<State>(std::move(name), final));
+            if (final) {
+                finalStates.push_back(states.back());
+            }
+            queue.push_back(id);
+        }
+        return id;
+    };
+
+    std::vector<std::shared_ptr<State>> initialStates;
+    for (const auto& state : automaton.getInitialStates()) {
+        const auto id = addState(frozen.getId(state.get()), 0);
+        if (std::find(initialStates.begin(), initialStates.end(), states[id]) == initialStates.end()) {
+            initialStates.push_back(states[id]);
+        }
+    }
+
+    TransitionsRelation::TransitionMap transitions;
+    while (!queue.empty()) {
+        const StateTupleTable::TupleId id = queue.front();
+        queue.pop_front();
+        const FrozenTransitions::StateId state = pairs.get(id, 0);
+        const std::uint32_t next = layers.nextLayer(state, pairs.get(id, 1));
+        for (const auto& edge : frozen.edges(state)) {
+            const auto target = addState(edge.target, next);
+            transitions[{states[id], edge.symbol}].push_back(states[target]);
+        }
+    }
+
+    return std::make_unique<Automaton>(
+        std::move(alphabet), initialStates, states, finalStates, std::move(transitions),
+        Automaton::OutputSymbolMap{}, std::move(outAlphabet));
+}
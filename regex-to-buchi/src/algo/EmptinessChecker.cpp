@@ -0,0 +1,110 @@
+#include <algo/EmptinessChecker.h>
+#include <cstdint>
+#include <stdexcept>
+
+EmptinessChecker::EmptinessChecker(const Automaton& automaton)
+    : frozen(automaton.freeze()), layers(automaton, frozen) {
+    for (FrozenTransitions::StateId state = 0; state < frozen.stateCount(); ++state) {
+        const auto row = frozen.edges(state);
+        // epsilon edges open every row
+        if (!row.empty() && row.begin()->symbol == SymbolTable::epsilon) {
+            throw std::invalid_argument("Emptiness check expects an automaton without epsilon transitions");
+        }
+    }
+
+    if (frozen.stateCount() * layers.layerCount() > UINT32_MAX) {
+        throw std::length_error("Automaton has too many states for the emptiness check");
+    }
+    for (const auto& state : automaton.getInitialStates()) {
+        initialStates.push_back(frozen.getId(state.get()));
+    }
+}
+
+EmptinessChecker::Frame EmptinessChecker::open(std::uint32_t node, SymbolId entry) const {
+    return Frame{node, frozen.edges(node / layers.layerCount()).begin(), entry};
+}
+
+std::uint32_t EmptinessChecker::successor(const Frame& frame, const FrozenTransitions::Edge& edge) const {
+    const std::uint32_t layerCount = layers.layerCount();
+    return edge.target * layerCount + layers.nextLayer(frame.node / layerCount, frame.node % layerCount);
+}
+
+std::optional<Lasso> EmptinessChecker::findAcceptingLasso() const {
+    enum Color : std::uint8_t { White, Cyan, Blue };
+    const std::uint32_t layerCount = layers.layerCount();
+    const std::size_t nodeCount = frozen.stateCount() * layerCount;
+    std::vector<Color> colors(nodeCount, White);
+    std::vector<bool> red(nodeCount, false);
+    std::vector<std::size_t> stackPosition(nodeCount, 0);  // valid while the node is cyan
+
+    std::vector<Frame> outer;
+    std::vector<Frame> inner;
+    for (StateId initial : initialStates) {
+        const std::uint32_t root = initial * layerCount;
+        if (colors[root] != White) {
+            continue;
+        }
+
+        colors[root] = Cyan;
+        stackPosition[root] = 0;
+        outer.push_back(open(root, SymbolTable::epsilon));
+        while (!outer.empty()) {
+            Frame& top = outer.back();
+            if (top.next != frozen.edges(top.node / layerCount).end()) {
+                const FrozenTransitions::Edge& edge = *top.next++;
+                const std::uint32_t child = successor(top, edge);
+                if (colors[child] == White) {
+                    colors[child] = Cyan;
+                    stackPosition[child] = outer.size();
+                    outer.push_back(open(child, edge.symbol));
+                }
+                continue;
+            }
+
+            // postorder: an accepting node looks for a way back onto the outer stack
+            const std::uint32_t seed = top.node;
+            if (layers.isAccepting(seed / layerCount, seed % layerCount) && !red[seed]) {
+                red[seed] = true;
+                inner.assign(1, open(seed, SymbolTable::epsilon));
+                while (!inner.empty()) {
+                    Frame& current = inner.back();
+                    if (current.next == frozen.edges(current.node / layerCount).end()) {
+                        inner.pop_back();
+                        continue;
+                    }
+
+                    const FrozenTransitions::Edge& edge = *current.next++;
+                    const std::uint32_t child = successor(current, edge);
+                    if (colors[child] == Cyan) {
+                        // u reaches the target along the outer stack, v goes on to the seed and back with the inner one
+                        const std::size_t position = stackPosition[child];
+                        Lasso lasso;
+                        for (std::size_t i = 1; i <= position; ++i) {
+                            lasso.prefix.push_back(outer[i].entry);
+                        }
+                        for (std::size_t i = position + 1; i < outer.size(); ++i) {
+                            lasso.cycle.push_back(outer[i].entry);
+                        }
+                        for (std::size_t i = 1; i < inner.size(); ++i) {
+                            lasso.cycle.push_back(inner[i].entry);
+                        }
+                        lasso.cycle.push_back(edge.symbol);
+                        return lasso;
+                    }
+                    if (!red[child]) {
+                        red[child] = true;
+                        inner.push_back(open(child, edge.symbol));
+                    }
+                }
+            }
+
+            colors[seed] = Blue;
+            outer.pop_back();
+        }
+    }
+    return std::nullopt;
+}
+
+bool EmptinessChecker::isEmpty() const {
+    return !findAcceptingLasso().has_value();
+}
@@ -0,0 +1,171 @@
+#include <algo/InclusionChecker.h>
+#include <algo/Degeneralizer.h>
+#include <array>
+#include <stdexcept>
+
+InclusionChecker::InclusionChecker(const Automaton& included, const Automaton& including)
+    : InclusionChecker(included.isGeneralized() ? *Degeneralizer::degeneralize(included) : included,
+                       BuchiComplement(including)) {}
+
+InclusionChecker::InclusionChecker(const Automaton& classic, BuchiComplement complement)
+    : included(classic.freeze()), complement(std::move(complement)), nodes(3) {
+    for (StateId state = 0; state < included.stateCount(); ++state) {
+        const auto row = included.edges(state);
+        // epsilon edges open every row
+        if (!row.empty() && row.begin()->symbol == SymbolTable::epsilon) {
+            throw std::invalid_argument("Inclusion check expects automata without epsilon transitions");
+        }
+    }
+
+    finalStates.assign(included.stateCount(), false);
+    for (const auto& state : classic.getFinalStates()) {
+        finalStates[included.getId(state.get())] = true;
+    }
+    for (const auto& state : classic.getInitialStates()) {
+        initialStates.push_back(included.getId(state.get()));
+    }
+}
+
+InclusionChecker::NodeId InclusionChecker::addNode(StateId state, BuchiComplement::ComplementId complementState,
+                                                   std::uint32_t layer) {
+    const std::array<StateTupleTable::StateId, 3> key{state, complementState, layer};
+    const NodeId node = nodes.intern(key.data());
+    if (rowBegin.size() < nodes.size()) {
+        rowBegin.push_back(unexpanded);
+        rowEnd.push_back(unexpanded);
+    }
+    return node;
+}
+
+InclusionChecker::Frame InclusionChecker::open(NodeId node, SymbolId entry) {
+    if (rowBegin[node] == unexpanded) {
+        const StateId state = nodes.get(node, 0);
+        const BuchiComplement::ComplementId complementState = nodes.get(node, 1);
+
+        // the layer moves on from 0 at a final state of A and from 1 at an accepting complement state
+        std::uint32_t layer = nodes.get(node, 2) == 2 ? 0 : nodes.get(node, 2);
+        if (layer == 0 && finalStates[state]) {
+            layer = 1;
+        }
+        if (layer == 1 && complement.isAccepting(complementState)) {
+            layer = 2;
+        }
+
+        // the row of A is sorted by symbol, so the complement successors are looked up once per symbol
+        std::vector<FrozenTransitions::Edge> row;
+        const std::vector<BuchiComplement::ComplementId>* targets = nullptr;
+        SymbolId symbol = SymbolTable::epsilon;
+        for (const auto& edge : included.edges(state)) {
+            if (targets == nullptr || edge.symbol != symbol) {
+                symbol = edge.symbol;
+                targets = &complement.successors(complementState, symbol);
+            }
+            for (BuchiComplement::ComplementId target : *targets) {
+                row.push_back({symbol, addNode(edge.target, target, layer)});
+            }
+        }
+        rowBegin[node] = static_cast<std::uint32_t>(edges.size());
+        edges.insert(edges.end(), row.begin(), row.end());
+        rowEnd[node] = static_cast<std::uint32_t>(edges.size());
+    }
+    return Frame{node, rowBegin[node], rowEnd[node], entry};
+}
+
+bool InclusionChecker::isAccepting(NodeId node) const {
+    return nodes.get(node, 2) == 2;
+}
+
+std::optional<Lasso> InclusionChecker::findCounterexample() {
+    enum Color : std::uint8_t { White, Cyan, Blue };
+    // nodes appear while the search runs, the marks grow with them
+    std::vector<Color> colors;
+    std::vector<bool> red;
+    std::vector<std::size_t> stackPosition;  // valid while the node is cyan
+    auto mark = [&](NodeId node) {
+        if (colors.size() < nodes.size()) {
+            colors.resize(nodes.size(), White);
+            red.resize(nodes.size(), false);
+            stackPosition.resize(nodes.size(), 0);
+        }
+        return node;
+    };
+
+    std::vector<Frame> outer;
+    std::vector<Frame> inner;
+    for (StateId initial : initialStates) {
+        const NodeId root = mark(addNode(initial, complement.getInitialState(), 0));
+        if (colors[root] != White) {
+            continue;
+        }
+
+        colors[root] = Cyan;
+        stackPosition[root] = 0;
+        outer.push_back(open(root, SymbolTable::epsilon));
+        while (!outer.empty()) {
+            Frame& top = outer.back();
+            if (top.next != top.end) {
+                const FrozenTransitions::Edge edge = edges[top.next++];
+                const NodeId child = mark(edge.target);
+                if (colors[child] == White) {
+                    colors[child] = Cyan;
+                    stackPosition[child] = outer.size();
+                    outer.push_back(open(child, edge.symbol));
+                }
+                continue;
+            }
+
+            // postorder: an accepting node looks for a way back onto the outer stack
+            const NodeId seed = top.node;
+            if (isAccepting(seed) && !red[seed]) {
+                red[seed] = true;
+                inner.assign(1, open(seed, SymbolTable::epsilon));
+                while (!inner.empty()) {
+                    Frame& current = inner.back();
+                    if (current.next == current.end) {
+                        inner.pop_back();
+                        continue;
+                    }
+
+                    const FrozenTransitions::Edge edge = edges[current.next++];
+                    const NodeId child = mark(edge.target);
+                    if (colors[child] == Cyan) {
+                        // u reaches the target along the outer stack, v goes on to the seed and back with the inner one
+                        const std::size_t position = stackPosition[child];
+                        Lasso lasso;
+                        for (std::size_t i = 1; i <= position; ++i) {
+                            lasso.prefix.push_back(outer[i].entry);
+                        }
+                        for (std::size_t i = position + 1; i < outer.size(); ++i) {
+                            lasso.cycle.push_back(outer[i].entry);
+                        }
+                        for (std::size_t i = 1; i < inner.size(); ++i) {
+                            lasso.cycle.push_back(inner[i].entry);
+                        }
+                        lasso.cycle.push_back(edge.symbol);
+                        return lasso;
+                    }
+                    if (!red[child]) {
+                        red[child] = true;
+                        inner.push_back(open(child, edge.symbol));
+                    }
+                }
+            }
+
+            colors[seed] = Blue;
+            outer.pop_back();
+        }
+    }
+    return std::nullopt;
+}
+
+bool InclusionChecker::isIncluded() {
+    return !findCounterexample().has_value();
+}
+
+std::size_t InclusionChecker::complementStateCount() const {
+    return complement.stateCount();
+}
+
+std::size_t InclusionChecker::productStateCount() const {
+    return nodes.size();
+}
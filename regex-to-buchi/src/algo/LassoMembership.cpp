@@ -0,0 +1,194 @@
+#include <algo/LassoMembership.h>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    enum Color : std::uint8_t { White, Cyan, Blue };
+}
+
+LassoMembership::LassoMembership(const Automaton& automaton)
+    : LassoMembership(automaton, automaton.freeze()) {}
+
+LassoMembership::LassoMembership(const Automaton& automaton, const FrozenTransitions& frozen)
+    : stateCount(frozen.stateCount()), layers(automaton, frozen) {
+    for (const auto& state : automaton.getInitialStates()) {
+        initialStates.push_back(frozen.getId(state.get()));
+    }
+
+    std::size_t columnCount = 0;
+    for (StateId state = 0; state < stateCount; ++state) {
+        for (const auto& edge : frozen.edges(state)) {
+            if (edge.symbol == SymbolTable::epsilon) {
+                throw std::invalid_argument("Lasso membership expects an automaton without epsilon transitions");
+            }
+            if (edge.symbol >= columns.size()) {
+                columns.resize(edge.symbol + 1, -1);
+            }
+            if (columns[edge.symbol] < 0) {
+                columns[edge.symbol] = static_cast<std::int32_t>(columnCount++);
+            }
+        }
+    }
+
+    // count the successors of every (symbol, state) row, then place them with a prefix sum over all rows
+    offsets.assign(columnCount * (stateCount + 1) + 1, 0);
+    for (StateId state = 0; state < stateCount; ++state) {
+        for (const auto& edge : frozen.edges(state)) {
+            ++offsets[columns[edge.symbol] * (stateCount + 1) + state + 1];
+        }
+    }
+    for (std::size_t row = 1; row < offsets.size(); ++row) {
+        offsets[row] += offsets[row - 1];
+    }
+
+    targets.resize(offsets.back());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (StateId state = 0; state < stateCount; ++state) {
+        for (const auto& edge : frozen.edges(state)) {
+            targets[cursor[columns[edge.symbol] * (stateCount + 1) + state]++] = edge.target;
+        }
+    }
+}
+
+bool LassoMembership::accepts(const Lasso& word) const {
+    Workspace workspace;
+    return accepts(word, workspace);
+}
+
+std::vector<bool> LassoMembership::acceptsAll(const std::vector<Lasso>& words) const {
+    Workspace workspace;
+    std::vector<bool> results;
+    results.reserve(words.size());
+    for (const Lasso& word : words) {
+        results.push_back(accepts(word, workspace));
+    }
+    return results;
+}
+
+std::pair<std::uint32_t, std::uint32_t> LassoMembership::successors(StateId state, SymbolId symbol) const {
+    if (symbol >= columns.size() || columns[symbol] < 0) {
+        return {0, 0};
+    }
+    const std::size_t row = columns[symbol] * (stateCount + 1) + state;
+    return {offsets[row], offsets[row + 1]};
+}
+
+bool LassoMembership::accepts(const Lasso& word, Workspace& workspace) const {
+    if (word.cycle.empty()) {
+        throw std::invalid_argument("Cycle of a lasso must not be empty");
+    }
+
+    // u is read over the set of states
+    auto& current = workspace.current;
+    auto& currentList = workspace.currentList;
+    auto& next = workspace.next;
+    auto& nextList = workspace.nextList;
+    current.assign(stateCount, false);
+    next.assign(stateCount, false);
+    currentList.clear();
+    for (StateId state : initialStates) {
+        if (!current[state]) {
+            current[state] = true;
+            currentList.push_back(state);
+        }
+    }
+    for (SymbolId symbol : word.prefix) {
+        nextList.clear();
+        for (StateId state : currentList) {
+            const auto [first, last] = successors(state, symbol);
+            for (std::uint32_t i = first; i < last; ++i) {
+                if (!next[targets[i]]) {
+                    next[targets[i]] = true;
+                    nextList.push_back(targets[i]);
+                }
+            }
+            current[state] = false;
+        }
+        std::swap(current, next);
+        std::swap(currentList, nextList);
+        if (currentList.empty()) {
+            return false;
+        }
+    }
+
+    // nested depth-first search over the product with the positions of v and the acceptance layers,
+    // node (state, i, layer) is (state * |v| + i) * layerCount + layer
+    const std::size_t length = word.cycle.size();
+    const std::uint32_t layerCount = layers.layerCount();
+    auto open = [this, &word, length, layerCount](std::uint32_t node) {
+        const std::uint32_t position = node / layerCount;
+        const auto [first, last] = successors(static_cast<StateId>(position / length), word.cycle[position % length]);
+        return Frame{node, first, last};
+    };
+    auto successor = [this, length, layerCount](const Frame& frame) {
+        const std::uint32_t position = frame.node / layerCount;
+        const std::uint32_t layer = layers.nextLayer(static_cast<StateId>(position / length), frame.node % layerCount);
+        return static_cast<std::uint32_t>((targets[frame.next] * length + (position % length + 1) % length) * layerCount
+                                          + layer);
+    };
+    auto accepting = [this, length, layerCount](std::uint32_t node) {
+        return layers.isAccepting(static_cast<StateId>(node / layerCount / length), node % layerCount);
+    };
+
+    const std::size_t nodeCount = stateCount * length * layerCount;
+    if (nodeCount > UINT32_MAX) {
+        throw std::length_error("Product of the automaton with the lasso cycle is too large");
+    }
+    auto& colors = workspace.colors;
+    auto& red = workspace.red;
+    auto& outer = workspace.outer;
+    auto& inner = workspace.inner;
+    colors.assign(nodeCount, White);
+    red.assign(nodeCount, false);
+    outer.clear();
+
+    for (StateId state : currentList) {
+        const auto root = static_cast<std::uint32_t>(state * length * layerCount);
+        if (colors[root] != White) {
+            continue;
+        }
+
+        colors[root] = Cyan;
+        outer.push_back(open(root));
+        while (!outer.empty()) {
+            Frame& top = outer.back();
+            if (top.next != top.end) {
+                const std::uint32_t child = successor(top);
+                ++top.next;
+                if (colors[child] == White) {
+                    colors[child] = Cyan;
+                    outer.push_back(open(child));
+                }
+                continue;
+            }
+
+            // postorder: a final state looks for a way back onto the outer stack
+            const std::uint32_t seed = top.node;
+            if (accepting(seed) && !red[seed]) {
+                red[seed] = true;
+                inner.assign(1, open(seed));
+                while (!inner.empty()) {
+                    Frame& frame = inner.back();
+                    if (frame.next == frame.end) {
+                        inner.pop_back();
+                        continue;
+                    }
+
+                    const std::uint32_t child = successor(frame);
+                    ++frame.next;
+                    if (colors[child] == Cyan) {
+                        return true;
+                    }
+                    if (!red[child]) {
+                        red[child] = true;
+                        inner.push_back(open(child));
+                    }
+                }
+            }
+
+            colors[seed] = Blue;
+            outer.pop_back();
+        }
+    }
+    return false;
+}
@@ -6,19 +6,47 @@
 #include <algorithm>
 #include <map>
 #include <stack>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    // Hash of an edge (from, symbol, to), used to filter duplicate transitions
+    struct EdgeHash {
+        size_t operator()(const std::tuple<const State*, SymbolId, const State*>& edge) const {
+            size_t seed = std::hash<const State*>{}(std::get<0>(edge));
+            seed ^= std::hash<SymbolId>{}(std::get<1>(edge)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<const State*>{}(std::get<2>(edge)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+}
 
 // Constructor
-RegexToNFA::RegexToNFA(const std::string& regex) : regex(regex), stateCounter(0) {}
+RegexToNFA::RegexToNFA(const std::string& regex) : regex(regex), position(0), stateCounter(0) {}
 
 void RegexToNFA::setStateCounter(int newCounter)
 {
     stateCounter = newCounter;
 }
 
+bool RegexToNFA::atEnd() const {
+    return position >= regex.size();
+}
+
+// Returns current character without consuming it, '\0' at the end of the input
+char RegexToNFA::peek() const {
+    return atEnd() ? '\0' : regex[position];
+}
+
+std::runtime_error RegexToNFA::parseError(const std::string& message) const {
+    return std::runtime_error(message + " at position " + std::to_string(position));
+}
+
 std::unique_ptr<Automaton> RegexToNFA::parseExpression() {
     auto result = parseTerm();
-    while (regex.length() > 0 && regex[0] == '|') {
-        regex = regex.substr(1);
+    while (!atEnd() && peek() == '|') {
+        ++position;
         auto right = parseTerm();
         result = handleDisjunction(std::move(result), std::move(right));
     }
@@ -27,7 +55,7 @@ std::unique_ptr<Automaton> RegexToNFA::parseExpression() {
 
 std::unique_ptr<Automaton> RegexToNFA::parseTerm() {
     auto result = parseFactor();
-    while (regex.length() > 0 && regex[0] != ')' && regex[0] != '|') {
+    while (!atEnd() && peek() != ')' && peek() != '|') {
         auto right = parseFactor();
         result = handleConcatenation(std::move(result), std::move(right));
     }
@@ -36,24 +64,23 @@ std::unique_ptr<Automaton> RegexToNFA::parseTerm() {
 
 std::unique_ptr<Automaton> RegexToNFA::parseFactor() {
     std::unique_ptr<Automaton> result;
-    if (regex.empty()) {
+    if (atEnd()) {
         return handleEmptyWord();
     }
 
-    if (regex.substr(0, 3) == "EPS") {
-        regex = regex.substr(3);
+    if (regex.compare(position, 3, "EPS") == 0) {
+        position += 3;
         return handleEmptyWord();
     }
 
-    char c = regex[0];
-    regex = regex.substr(1);
+    char c = regex[position++];
 
     if (c == '(') {
         result = parseExpression();
-        if (regex[0] == ')') {
-            regex = regex.substr(1);
+        if (peek() == ')') {
+            ++position;
         } else {
-            throw std::runtime_error("Mismatched parentheses");
+            throw parseError("Mismatched parentheses");
         }
     } else {
         std::string c_str(1, c);
@@ -61,16 +88,16 @@ std::unique_ptr<Automaton> RegexToNFA::parseFactor() {
     }
 
     // iteration processing
-    while (regex.length() > 0 && regex[0] == '*') {
+    while (!atEnd() && peek() == '*') {
         result = handleKleeneStar(std::move(result));
-        regex = regex.substr(1);
+        ++position;
     }
 
     // strong iteration processing
-    while (regex.length() > 0 && regex[0] == '^') {
+    while (!atEnd() && peek() == '^') {
         result = handleKleeneStar(std::move(result));
         result = handleStrongIteration(std::move(result));
-        regex = regex.substr(1);
+        ++position;
     }
 
     return result;
@@ -85,46 +112,74 @@ std::shared_ptr<State> RegexToNFA::createState(bool isFinal) {
 
 void RegexToNFA::addTransition(TransitionsRelation::TransitionMap& transitions,
                           const std::shared_ptr<State>& from,
-                          const std::string& symbol,
+                          SymbolId symbol,
                           const std::shared_ptr<State>& to,
                           Automaton::OutputSymbolMap& outs,
-                          const std::string& out
+                          SymbolId out
 ) {
     TransitionsRelation::TransitionKey key = std::make_pair(from, symbol);
-    auto it = transitions.find(key);
-    if (it != transitions.end()) {
-        if (std::find(it->second.begin(), it->second.end(), to) == it->second.end()) {
-            it->second.push_back(to);
-        }
-    } else {
-        transitions.insert({key, {to}});
+    auto& targets = transitions[key];
+    if (std::find(targets.begin(), targets.end(), to) != targets.end()) {
+        return;
     }
-
+    // outputs are aligned with the targets, one per target
+    targets.push_back(to);
     outs[key].push_back(out);
 }
 
-std::pair<std::unique_ptr<Alphabet>, std::unique_ptr<Alphabet>> RegexToNFA::mergeAlphabets(
-    const std::unique_ptr<Automaton>& left, const std::unique_ptr<Automaton>& right
-){
-    auto newAlphabet = std::make_unique<Alphabet>(left->_getAlphabet()->_getLetters());
-    auto& newAlphabetLetters = newAlphabet->_getLetters();
-    const auto& rightAlphabetLetters = right->_getAlphabet()->_getLetters();
-    for (const std::string& c : rightAlphabetLetters) {
-        if (std::find(newAlphabetLetters.begin(), newAlphabetLetters.end(), c) == newAlphabetLetters.end()) {
-            newAlphabetLetters.push_back(c);
+void RegexToNFA::mergeAlphabets(Automaton& into, const Automaton& from) {
+    auto& letters = into._getAlphabet()->_getLetters();
+    for (const std::string& c : from.getAlphabet()->getLetters()) {
+        if (std::find(letters.begin(), letters.end(), c) == letters.end()) {
+            letters.push_back(c);
+        }
+    }
+
+    auto& outLetters = into.getOutputAlphabet()->_getLetters();
+    for (const std::string& c : from.getOutputAlphabet()->_getLetters()) {
+        if (std::find(outLetters.begin(), outLetters.end(), c) == outLetters.end()) {
+            outLetters.push_back(c);
         }
     }
+}
 
-    auto newOutAlphabet = std::make_unique<Alphabet>(left->getOutputAlphabet()->_getLetters());
-    auto& newOutAlphabetLetters = newOutAlphabet->_getLetters();
-    const auto& rightOutAlphabetLetters = right->getOutputAlphabet()->_getLetters();
-    for (const std::string& c : rightOutAlphabetLetters) {
-        if (std::find(newOutAlphabetLetters.begin(), newOutAlphabetLetters.end(), c) == newOutAlphabetLetters.end()) {
-            newOutAlphabetLetters.push_back(c);
+/**
+ * Moves transitions and outputs of from into into. Operands never share states, so nodes of the smaller maps
+ * are spliced into the larger ones instead of being copied edge by edge.
+ */
+void RegexToNFA::spliceTransitions(Automaton& into, Automaton& from) {
+    auto& transitions = into._getTransitionsRelation()->_getTransitions();
+    auto& outs = into._getOutputFunction();
+    auto& fromTransitions = from._getTransitionsRelation()->_getTransitions();
+    auto& fromOuts = from._getOutputFunction();
+
+    if (transitions.size() < fromTransitions.size()) {
+        transitions.swap(fromTransitions);
+        outs.swap(fromOuts);
+    }
+    transitions.merge(fromTransitions);
+    outs.merge(fromOuts);
+
+    // keys present in both automata stay behind
+    for (const auto& [key, value] : fromTransitions) {
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            const auto& fromOut = fromOuts[key];
+            addTransition(transitions, key.first, key.second, value[i], outs, i < fromOut.size() ? fromOut[i] : SymbolTable::empty);
         }
     }
+    fromTransitions.clear();
+    fromOuts.clear();
+}
 
-    return std::make_pair(std::move(newAlphabet), std::move(newOutAlphabet));
+// Moves states of from into into, the smaller vector is appended to the larger one (so the order is not kept)
+void RegexToNFA::spliceStates(Automaton& into, Automaton& from) {
+    auto& states = into._getStates();
+    auto& fromStates = from._getStates();
+    if (states.size() < fromStates.size()) {
+        states.swap(fromStates);
+    }
+    states.insert(states.end(), std::make_move_iterator(fromStates.begin()), std::make_move_iterator(fromStates.end()));
+    fromStates.clear();
 }
 
 std::unique_ptr<Automaton> RegexToNFA::handleElementaryLanguage(
@@ -134,7 +189,7 @@ std::unique_ptr<Automaton> RegexToNFA::handleElementaryLanguage(
     auto finalState = createState(true);
     TransitionsRelation::TransitionMap transitions;
     Automaton::OutputSymbolMap outs;
-    addTransition(transitions, initialState, input, finalState, outs, output);
+    addTransition(transitions, initialState, SymbolTable::intern(input), finalState, outs, SymbolTable::intern(output));
 
     return std::make_unique<Automaton>(
         std::make_unique<Alphabet>(std::vector<std::string>{input}),
@@ -166,147 +221,92 @@ std::unique_ptr<Automaton> RegexToNFA::handleDisjunction(
     auto newInitialState = createState();
     auto newFinalState = createState(true);
 
-    auto newTransitions = left->getTransitionsRelation()->getTransitions();
-    auto newOutFunction = left->getOutputFunction();
-
-    auto rightOuts = right->getOutputFunction();
-
-    // Add all transitions from right automata
-    for (const auto& [key, value] : right->getTransitionsRelation()->getTransitions()) {
-        int counter = 0;
-        for (const auto& toState : value) {
-            // Check if rightOuts contains the key and if the counter index is valid
-            std::string outputSymbol = std::string(1, '\0');
-            if (rightOuts.find(key) != rightOuts.end() && counter < rightOuts[key].size()) {
-                outputSymbol = rightOuts[key][counter];
-            }
-            // Add the transition, using the output symbol or an empty string
-            addTransition(newTransitions, key.first, key.second, toState,
-                          newOutFunction, outputSymbol);
-            counter++;
-        }
-    }
+    // Take over transitions and outputs of both automata
+    spliceTransitions(*left, *right);
+    auto& newTransitions = left->_getTransitionsRelation()->_getTransitions();
+    auto& newOutFunction = left->_getOutputFunction();
 
     // Connect new initial state to both left and right initial states
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), left->getInitialStates()[0],
-        newOutFunction, "");
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), right->getInitialStates()[0],
-        newOutFunction, "");
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, left->getInitialStates()[0],
+        newOutFunction, SymbolTable::empty);
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, right->getInitialStates()[0],
+        newOutFunction, SymbolTable::empty);
 
     // Connect all final states to the new final state
     for (const auto& finalState : left->getFinalStates()) {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newFinalState,
-            newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newFinalState,
+            newOutFunction, SymbolTable::empty);
     }
     for (const auto& finalState : right->getFinalStates()) {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newFinalState,
-            newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newFinalState,
+            newOutFunction, SymbolTable::empty);
     }
 
     // Merge states
-    auto newStates = left->getStates();
-    newStates.insert(newStates.end(), right->getStates().begin(), right->getStates().end());
-    newStates.push_back(newInitialState);
-    newStates.push_back(newFinalState);
+    spliceStates(*left, *right);
+    left->_getStates().push_back(newInitialState);
+    left->_getStates().push_back(newFinalState);
 
     // Merge alphabets
-    auto [inAlphabet, outAlphabet] = mergeAlphabets(left, right);
+    mergeAlphabets(*left, *right);
 
-    return std::make_unique<Automaton>(
-        std::move(inAlphabet),
-        std::vector<std::shared_ptr<State>>{newInitialState},
-        newStates,
-        std::vector<std::shared_ptr<State>>{newFinalState},
-        newTransitions,
-        newOutFunction,
-        std::move(outAlphabet)
-    );
+    left->setInitialStates({newInitialState});
+    left->setFinalStates({newFinalState});
+    return left;
 }
 
 std::unique_ptr<Automaton> RegexToNFA::handleConcatenation(
     std::unique_ptr<Automaton> left, std::unique_ptr<Automaton> right
     ) {
-    auto newTransitions = left->getTransitionsRelation()->getTransitions();
-
-    auto newOutFunction = left->getOutputFunction();
-    auto rightOuts = right->getOutputFunction();
-
-    // Add all transitions from right automata
-    for (const auto& [key, value] : right->getTransitionsRelation()->getTransitions()) {
-        int counter = 0;
-        for (const auto& toState : value) {
-            // Check if rightOuts contains the key and if the counter index is valid
-            std::string outputSymbol = "";
-            if (rightOuts.find(key) != rightOuts.end() && counter < rightOuts[key].size()) {
-                outputSymbol = rightOuts[key][counter];
-            }
-            // Add the transition, using the output symbol or an empty string
-            addTransition(newTransitions, key.first, key.second, toState,
-                          newOutFunction, outputSymbol);
-            counter++;
-        }
-    }
+    // Take over transitions and outputs of both automata
+    spliceTransitions(*left, *right);
+    auto& newTransitions = left->_getTransitionsRelation()->_getTransitions();
+    auto& newOutFunction = left->_getOutputFunction();
 
     // Connect final states of left to initial state of right
     for (const auto& finalState : left->getFinalStates()) {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), right->getInitialStates()[0],
-            newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, right->getInitialStates()[0],
+            newOutFunction, SymbolTable::empty);
     }
 
     // Merge states and set new final states
-    auto newStates = left->getStates();
-    newStates.insert(newStates.end(), right->getStates().begin(), right->getStates().end());
+    spliceStates(*left, *right);
 
     // Merge alphabets
-    auto [inAlphabet, outAlphabet] = mergeAlphabets(left, right);
-
+    mergeAlphabets(*left, *right);
 
-    return std::make_unique<Automaton>(
-        std::move(inAlphabet),
-        left->getInitialStates(),
-        newStates,
-        right->getFinalStates(),
-        newTransitions,
-        newOutFunction,
-        std::move(outAlphabet)
-    );
+    left->setFinalStates(right->getFinalStates());
+    return left;
 }
 
 std::unique_ptr<Automaton> RegexToNFA::handleKleeneStar(std::unique_ptr<Automaton> automata) {
     auto newInitialState = createState();
     auto newFinalState = createState(true);
 
-    auto newTransitions = automata->getTransitionsRelation()->getTransitions();
-    auto newOutFunction = automata->getOutputFunction();
+    auto& newTransitions = automata->_getTransitionsRelation()->_getTransitions();
+    auto& newOutFunction = automata->_getOutputFunction();
 
     // Connect new initial state to new final state and old initial state
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), newFinalState,
-        newOutFunction, "");
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), automata->getInitialStates()[0],
-        newOutFunction, "");
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, newFinalState,
+        newOutFunction, SymbolTable::empty);
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, automata->getInitialStates()[0],
+        newOutFunction, SymbolTable::empty);
 
     // Connect old final states to new final state and old initial state
     for (const auto& finalState : automata->getFinalStates()) {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newFinalState,
-            newOutFunction, "");
-        addTransition(newTransitions, finalState, std::string(1, '\0'), automata->getInitialStates()[0],
-            newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newFinalState,
+            newOutFunction, SymbolTable::empty);
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, automata->getInitialStates()[0],
+            newOutFunction, SymbolTable::empty);
     }
 
     // Add new states
-    auto newStates = automata->getStates();
-    newStates.push_back(newInitialState);
-    newStates.push_back(newFinalState);
+    automata->_getStates().push_back(newInitialState);
+    automata->_getStates().push_back(newFinalState);
 
-    return std::make_unique<Automaton>(
-        std::make_unique<Alphabet>(automata->_getAlphabet()->_getLetters()),
-        std::vector<std::shared_ptr<State>>{newInitialState},
-        newStates,
-        std::vector<std::shared_ptr<State>>{newFinalState},
-        newTransitions,
-        newOutFunction,
-        std::make_unique<Alphabet>(automata->getOutputAlphabet()->getLetters())
-    );
+    automata->setInitialStates({newInitialState});
+    automata->setFinalStates({newFinalState});
+    return automata;
 }
 
 std::unique_ptr<Automaton> RegexToNFA::handleStrongIteration(std::unique_ptr<Automaton> automata)
@@ -314,40 +314,28 @@ std::unique_ptr<Automaton> RegexToNFA::handleStrongIteration(std::unique_ptr<Aut
     // Create a new initial state (this state will also act as an entry point for looping)
     auto newInitialState = createState(true);
 
-    // Retrieve the original automaton's transitions and output function
-    auto newTransitions = automata->getTransitionsRelation()->getTransitions();
-    auto newOutFunction = automata->getOutputFunction();
+    // Take over the original automaton's transitions and output function
+    auto& newTransitions = automata->_getTransitionsRelation()->_getTransitions();
+    auto& newOutFunction = automata->_getOutputFunction();
 
     // Connect the new initial state to the original initial state using an epsilon transition
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), automata->getInitialStates()[0],
-        newOutFunction, "");
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, automata->getInitialStates()[0],
+        newOutFunction, SymbolTable::empty);
 
     // Loop from each original final state back to the original initial state
     for (const auto& finalState : automata->getFinalStates()) {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newInitialState,
-            newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newInitialState,
+            newOutFunction, SymbolTable::empty);
     }
 
     // Also add a self-loop on the new initial state to handle cases where the repetition starts over
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), newInitialState,
-        newOutFunction, "");
-
-    // Collect all states from the original automaton and add the new initial state
-    auto newStates = automata->getStates();
-    auto newFinalStates = automata->getFinalStates();
-    newStates.push_back(newInitialState);
-    // newFinalStates.push_back(newInitialState);
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, newInitialState,
+        newOutFunction, SymbolTable::empty);
 
-    // Return a new automaton with the modified structure
-    return std::make_unique<Automaton>(
-        std::make_unique<Alphabet>(automata->_getAlphabet()->_getLetters()),
-        std::vector<std::shared_ptr<State>>{newInitialState},
-        newStates,
-        newFinalStates, // Use the original final states as markers
-        newTransitions,
-        newOutFunction,
-        std::make_unique<Alphabet>(automata->getOutputAlphabet()->getLetters())
-    );
+    // Add the new initial state, the original final states stay as markers
+    automata->_getStates().push_back(newInitialState);
+    automata->setInitialStates({newInitialState});
+    return automata;
 }
 
 std::set<std::shared_ptr<State>> RegexToNFA::findEpsilonClosure(
@@ -365,7 +353,7 @@ std::set<std::shared_ptr<State>> RegexToNFA::findEpsilonClosure(
         closure.insert(currentState);
 
         for (const auto& [key, value] : transitions) {
-            if (key.first == currentState && key.second == std::string(1, '\0')) {
+            if (key.first == currentState && key.second == SymbolTable::epsilon) {
                 for (const auto& nextState : value) {
                     if (closure.find(nextState) == closure.end()) {
                         stack.push(nextState);
@@ -381,7 +369,7 @@ std::set<std::shared_ptr<State>> RegexToNFA::findEpsilonClosure(
 void RegexToNFA::buildNewTransitions(
     const TransitionsRelation::TransitionMap& oldTransitions,
     TransitionsRelation::TransitionMap& newTransitions,
-    Automaton::OutputSymbolMap& oldOutFunction,
+    const Automaton::OutputSymbolMap& oldOutFunction,
     Automaton::OutputSymbolMap& newOutFunction,
     const std::vector<std::shared_ptr<State>>& states)
 {
@@ -390,14 +378,16 @@ void RegexToNFA::buildNewTransitions(
 
         for (const auto& closureState : closure) {
             for (const auto& [key, value] : oldTransitions) {
-                int counter = 0;
-                if (key.first == closureState && key.second != std::string(1, '\0')) {
-                    for (const auto& reachableState : value) {
-                        addTransition(newTransitions, state, key.second, reachableState,
-                            newOutFunction, oldOutFunction[key][counter]);
-                    }
+                if (key.first != closureState || key.second == SymbolTable::epsilon) {
+                    continue;
+                }
+                // the output of a target sits at the same position, an edge without one outputs nothing
+                const auto outs = oldOutFunction.find(key);
+                for (size_t i = 0; i < value.size(); ++i) {
+                    const bool hasOut = outs != oldOutFunction.end() && i < outs->second.size();
+                    addTransition(newTransitions, state, key.second, value[i],
+                        newOutFunction, hasOut ? outs->second[i] : SymbolTable::empty);
                 }
-                counter++;
             }
         }
     }
@@ -494,11 +484,12 @@ void RegexToNFA::removeEpsilonTransitions(std::unique_ptr<Automaton>& automata)
     automata->setOutputFunction(newOutFunction);
 }
 
-bool RegexToNFA::hasState(std::vector<std::shared_ptr<State>> states, std::shared_ptr<State> state)
-{
-    return std::find(states.begin(), states.end(), state) != states.end();
-}
-
+/**
+ * Keeps one initial and one final state: the other initial states hand their in- and out-edges over to the
+ * selected initial state, the other final states hand theirs over to the selected final state.
+ * Edges of the excess states are indexed in one pass and duplicates are filtered by a hash set, so the whole
+ * normalization is O(transitions).
+ */
 void RegexToNFA::makeTwoPoleAutomaton(std::unique_ptr<Automaton>& automaton) {
     // Ensure there are initial and final states to process
     if (automaton->getInitialStates().empty() || automaton->getFinalStates().empty()) {
@@ -506,13 +497,14 @@ void RegexToNFA::makeTwoPoleAutomaton(std::unique_ptr<Automaton>& automaton) {
     }
 
     // Try to select a state that is both initial and final
-    auto initialStates = automaton->getInitialStates();
-    auto finalStates = automaton->getFinalStates();
+    const auto initialStates = automaton->getInitialStates();
+    const auto finalStates = automaton->getFinalStates();
+    const std::unordered_set<std::shared_ptr<State>> finalSet(finalStates.begin(), finalStates.end());
     std::shared_ptr<State> selectedInitialState = nullptr;
     std::shared_ptr<State> selectedFinalState = nullptr;
 
     for (const auto& initialState : initialStates) {
-        if (this->hasState(finalStates, initialState)) {
+        if (finalSet.count(initialState)) {
             // Found a state that is both initial and final
             selectedInitialState = initialState;
             selectedFinalState = initialState;
@@ -526,103 +518,95 @@ void RegexToNFA::makeTwoPoleAutomaton(std::unique_ptr<Automaton>& automaton) {
         selectedFinalState = finalStates[0];
     }
 
-    // Get the current transitions
-    auto existingTransitions = automaton->getTransitionsRelation()->getTransitions();
-    TransitionsRelation::TransitionMap newTransitions;
-    Automaton::OutputSymbolMap newOutFunction;
-
-    // Loop through all initial states
-    for (const auto& initialState : automaton->getInitialStates()) {
-        if (initialState != selectedInitialState) {
-            // Redirect transitions from the current initial state
-            for (const auto& transition : existingTransitions) {
-                auto fromState = transition.first.first;
-                auto symbol = transition.first.second;
-                const auto& toStates = transition.second;
-
-                // If the transition originates from the current initial state
-                if (fromState == initialState) {
-                    for (const auto& toState : toStates) {
-                        // Add a new transition from the selected initial state
-                        addTransition(
-                            newTransitions, selectedInitialState,
-                            symbol, toState, newOutFunction, ""
-                            );
-                    }
-                }
-
-                // If the transition leads to the current initial state
-                for (const auto& toState : toStates) {
-                    if (toState == initialState) {
-                        // Redirect to the selected initial state
-                        addTransition(
-                            newTransitions, fromState, symbol,
-                            selectedInitialState, newOutFunction, ""
-                            );
-                    }
-                }
-            }
+    // Excess states and the edges entering and leaving them, gathered in a single pass
+    struct Edge {
+        std::shared_ptr<State> state;  // the other end of the edge
+        SymbolId symbol;
+        SymbolId output;
+    };
+    std::unordered_map<std::shared_ptr<State>, std::vector<Edge>> outEdges;
+    std::unordered_map<std::shared_ptr<State>, std::vector<Edge>> inEdges;
+    for (const auto& state : initialStates) {
+        if (state != selectedInitialState) {
+            outEdges[state];
+            inEdges[state];
+        }
+    }
+    for (const auto& state : finalStates) {
+        if (state != selectedFinalState) {
+            outEdges[state];
+            inEdges[state];
         }
     }
 
-    // Loop through all final states
-    for (const auto& finalState : automaton->getFinalStates()) {
-        if (finalState != selectedFinalState) {
-            // Redirect transitions to the current final state
-            for (const auto& transition : existingTransitions) {
-                auto fromState = transition.first.first;
-                auto symbol = transition.first.second;
-                const auto& toStates = transition.second;
-
-                // If the transition leads to the current final state
-                for (const auto& toState : toStates) {
-                    if (toState == finalState) {
-                        // Add a new transition to the selected final state
-                        addTransition(
-                            newTransitions, fromState, symbol,
-                            selectedFinalState, newOutFunction, ""
-                            );
-                    }
-                }
-
-                // If the transition originates from the current final state
-                if (fromState == finalState) {
-                    for (const auto& toState : toStates) {
-                        // Redirect from the selected final state
-                        addTransition(
-                            newTransitions, selectedFinalState,
-                            symbol, toState, newOutFunction, ""
-                            );
-                    }
-                }
+    const auto& existingTransitions = automaton->getTransitionsRelation()->getTransitions();
+    const auto& existingOuts = automaton->getOutSymbolsRelation();
+    for (const auto& [key, toStates] : existingTransitions) {
+        auto out = outEdges.find(key.first);
+        const auto outs = existingOuts.find(key);
+        for (size_t i = 0; i < toStates.size(); ++i) {
+            const auto& toState = toStates[i];
+            const SymbolId output = outs != existingOuts.end() && i < outs->second.size()
+                ? outs->second[i] : SymbolTable::empty;
+            if (out != outEdges.end()) {
+                out->second.push_back({toState, key.second, output});
+            }
+            auto in = inEdges.find(toState);
+            if (in != inEdges.end()) {
+                in->second.push_back({key.first, key.second, output});
             }
         }
     }
 
-    // Copy over transitions that don't involve excess initial or final states
-    for (const auto& transition : existingTransitions) {
-        auto fromState = transition.first.first;
-        auto symbol = transition.first.second;
-        const auto& toStates = transition.second;
-
+    // Existing transitions stay, redirected ones are added unless already present and keep their output
+    TransitionsRelation::TransitionMap newTransitions = existingTransitions;
+    Automaton::OutputSymbolMap newOuts = existingOuts;
+    std::unordered_set<std::tuple<const State*, SymbolId, const State*>, EdgeHash> present;
+    for (const auto& [key, toStates] : existingTransitions) {
         for (const auto& toState : toStates) {
-            // Add existing transitions that are unrelated to excess states
-            addTransition(
-                newTransitions, fromState, symbol,
-                toState, newOutFunction, ""
-                );
+            present.emplace(key.first.get(), key.second, toState.get());
+        }
+    }
+    auto addEdge = [&newTransitions, &newOuts, &present](const std::shared_ptr<State>& from, SymbolId symbol,
+                                                         const std::shared_ptr<State>& to, SymbolId output) {
+        if (present.emplace(from.get(), symbol, to.get()).second) {
+            auto& targets = newTransitions[{from, symbol}];
+            auto& outs = newOuts[{from, symbol}];
+            // pad a shorter output vector so the new output lands next to its target
+            outs.resize(targets.size(), SymbolTable::empty);
+            targets.push_back(to);
+            outs.push_back(output);
+        }
+    };
+
+    auto redirect = [&](const std::shared_ptr<State>& state, const std::shared_ptr<State>& selected) {
+        for (const Edge& edge : outEdges[state]) {
+            addEdge(selected, edge.symbol, edge.state, edge.output);
+        }
+        for (const Edge& edge : inEdges[state]) {
+            addEdge(edge.state, edge.symbol, selected, edge.output);
+        }
+    };
+    for (const auto& initialState : initialStates) {
+        if (initialState != selectedInitialState) {
+            redirect(initialState, selectedInitialState);
+        }
+    }
+    for (const auto& finalState : finalStates) {
+        if (finalState != selectedFinalState) {
+            redirect(finalState, selectedFinalState);
         }
     }
 
     // Update the automaton with the new transitions
-    automaton->_getTransitionsRelation()->setTransitions(newTransitions);
+    automaton->_getTransitionsRelation()->_getTransitions() = std::move(newTransitions);
+    automaton->_getOutputFunction() = std::move(newOuts);
 
     // Set only the selected initial and final states
     automaton->setInitialStates({ selectedInitialState });
     automaton->setFinalStates({ selectedFinalState });
 }
 
-
 void RegexToNFA::makeOmegaAutomaton(std::unique_ptr<Automaton>& automaton)
 {
     automaton = this->handleKleeneStar(std::move(automaton));
@@ -657,7 +641,11 @@ std::unique_ptr<Automaton> RegexToNFA::makeConcatenatedAutomaton(
 }
 
 std::unique_ptr<Automaton> RegexToNFA::convertToNFA() {
+    position = 0;
     std::unique_ptr<Automaton> nfa = parseExpression();
+    if (!atEnd()) {
+        throw parseError(std::string("Unexpected '") + peek() + "'");
+    }
 
     removeEpsilonTransitions(nfa);
 
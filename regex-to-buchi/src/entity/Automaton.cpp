@@ -18,9 +18,7 @@ Automaton::Automaton(std::unique_ptr<Alphabet> alphabet,
                    std::vector<std::shared_ptr<State>> states,
                    std::vector<std::shared_ptr<State>> finalStates,
                    TransitionsRelation::TransitionMap transitionMap,
-                   const std::unordered_map<
-                        std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash
-                    >& outSymbolsMap,
+                   OutputSymbolMap outSymbolsMap,
                     std::unique_ptr<Alphabet> outAlphabet
                     )
     : alphabet(std::move(alphabet)),
@@ -28,7 +26,7 @@ Automaton::Automaton(std::unique_ptr<Alphabet> alphabet,
       states(std::move(states)),
       finalStates(std::move(finalStates)),
       transitionsRelation(std::make_unique<TransitionsRelation>(std::move(transitionMap))),
-      outSymbolsRelation(outSymbolsMap),
+      outSymbolsRelation(std::move(outSymbolsMap)),
       outAlphabet(std::move(outAlphabet))
 {}
 
@@ -38,6 +36,7 @@ Automaton::Automaton(const Automaton &other)
     , initialStates(other.initialStates)
     , states(other.states)
     , finalStates(other.finalStates)
+    , acceptanceSets(other.acceptanceSets)
     , transitionsRelation(std::make_unique<TransitionsRelation>(*other.transitionsRelation))
     , outSymbolsRelation(other.outSymbolsRelation) {};
 
@@ -57,7 +56,7 @@ std::unique_ptr<Automaton> Automaton::clone() const {
     std::unique_ptr<TransitionsRelation> newTransitionsRelation = std::make_unique<TransitionsRelation>(oldTransitions);
 
     // Create a new automaton with the cloned data
-    return std::make_unique<Automaton>(
+    auto copy = std::make_unique<Automaton>(
         std::move(newAlphabet),
         newInitialStates,
         newStates,
@@ -65,6 +64,8 @@ std::unique_ptr<Automaton> Automaton::clone() const {
         newTransitionsRelation->getTransitions(),
         outSymbolsRelation
     );
+    copy->acceptanceSets = acceptanceSets;
+    return copy;
 }
 
 
@@ -101,6 +102,15 @@ void Automaton::print() const {
     }
     std::cout << '\n';
 
+    // Print further acceptance sets of a generalized automaton
+    for (std::size_t i = 0; i < acceptanceSets.size(); ++i) {
+        std::cout << "Acceptance Set " << i + 1 << ": ";
+        for (const auto& state : acceptanceSets[i]) {
+            std::cout << state->getName() << ' ';
+        }
+        std::cout << '\n';
+    }
+
     // Print all states
     std::cout << "States: ";
     for (const auto& state : states) {
@@ -112,7 +122,7 @@ void Automaton::print() const {
     std::cout << "Transitions:\n";
     for (const auto& [key, nextStates] : transitionsRelation->getTransitions()) {
         const auto& fromState = key.first;
-        const std::string& input = key.second;
+        const std::string& input = SymbolTable::getName(key.second);
 
         // Retrieve the corresponding output symbols for the current transition
         auto outSymbolIt = outSymbolsRelation.find(key);
@@ -178,7 +188,7 @@ const std::unordered_map<std::string, std::vector<std::string>> Automaton::getAu
 
     for (const auto& [key, nextStates] : transitionsRelation->getTransitions()) {
         const auto& fromState = key.first;
-        const std::string& input = key.second;
+        const std::string& input = SymbolTable::getName(key.second);
 
         std::string new_transition {""};
 
@@ -186,13 +196,10 @@ const std::unordered_map<std::string, std::vector<std::string>> Automaton::getAu
 
         new_transition += fromState->getName() + "/" + input +"/";
 
-        std::vector<std::string> outSymbolsForState;
         if (outSymbolIt != outSymbolsRelation.end()){
-            outSymbolsForState = outSymbolIt->second;
-        }
-        
-        for (size_t j = 0; j < outSymbolsForState.size(); ++j) {
-            new_transition += outSymbolsForState[j];
+            for (SymbolId out : outSymbolIt->second) {
+                new_transition += SymbolTable::getName(out);
+            }
         }
         new_transition += "/";
         std::set<std::string> toStateNames;
@@ -240,6 +247,10 @@ Automaton::OutputSymbolMap Automaton::getOutputFunction() const
     return outSymbolsRelation;
 }
 
+Automaton::OutputSymbolMap& Automaton::_getOutputFunction() {
+    return outSymbolsRelation;
+}
+
 void Automaton::setOutputFunction(const Automaton::OutputSymbolMap& out)
 {
     this->outSymbolsRelation = out;
@@ -253,18 +264,33 @@ const std::vector<std::shared_ptr<State>>& Automaton::getStates() const {
     return states;
 }
 
+std::vector<std::shared_ptr<State>>& Automaton::_getStates() {
+    return states;
+}
+
 const std::vector<std::shared_ptr<State>>& Automaton::getFinalStates() const {
     return finalStates;
 }
 
-const std::unordered_map<std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash
-    >& Automaton::getOutSymbolsRelation() const {
+std::size_t Automaton::getAcceptanceSetCount() const {
+    return 1 + acceptanceSets.size();
+}
+
+const std::vector<std::shared_ptr<State>>& Automaton::getAcceptanceSet(std::size_t index) const {
+    return index == 0 ? finalStates : acceptanceSets.at(index - 1);
+}
+
+bool Automaton::isGeneralized() const {
+    return !acceptanceSets.empty();
+}
+
+const Automaton::OutputSymbolMap& Automaton::getOutSymbolsRelation() const {
     return outSymbolsRelation;
 }
 
-std::vector<std::string> Automaton::getOutputOfTransition(const std::shared_ptr<State> &current, const std::string &input) const {
+std::vector<SymbolId> Automaton::getOutputOfTransition(const std::shared_ptr<State> &current, SymbolId input) const {
 
-    const std::pair<std::shared_ptr<State>, std::string> key = std::make_pair(current, input);
+    const TransitionsRelation::TransitionKey key = std::make_pair(current, input);
     auto it = outSymbolsRelation.find(key);
     if (it != outSymbolsRelation.end()) {
         return it->second;
@@ -297,6 +323,10 @@ void Automaton::setFinalStates(const std::vector<std::shared_ptr<State>>& newFin
     finalStates = newFinalStates;
 }
 
+void Automaton::addAcceptanceSet(std::vector<std::shared_ptr<State>> acceptanceSet) {
+    acceptanceSets.push_back(std::move(acceptanceSet));
+}
+
 void Automaton::setTransitionsRelation(std::unique_ptr<TransitionsRelation> newTransitionsRelation) {
     transitionsRelation = std::move(newTransitionsRelation);
 }
@@ -325,3 +355,13 @@ bool Automaton::isDeterministic() const {
     }
     return true;
 }
+
+FrozenTransitions Automaton::freeze() const {
+    std::vector<std::shared_ptr<State>> order = initialStates;
+    order.insert(order.end(), states.begin(), states.end());
+    order.insert(order.end(), finalStates.begin(), finalStates.end());
+    for (const auto& acceptanceSet : acceptanceSets) {
+        order.insert(order.end(), acceptanceSet.begin(), acceptanceSet.end());
+    }
+    return FrozenTransitions(order, transitionsRelation->getTransitions());
+}
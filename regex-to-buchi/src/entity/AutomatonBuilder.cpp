@@ -62,7 +62,7 @@ AutomatonBuilder& AutomatonBuilder::setTransitions(
         const size_t size = inputs.size();
 
         for (size_t i = 0; i < size; ++i) {
-            const std::string& input = inputs[i];
+            const SymbolId input = SymbolTable::intern(inputs[i]);
 
             // Add transition for the input
             transitions[{fromState, input}].push_back(toState);
@@ -72,11 +72,11 @@ AutomatonBuilder& AutomatonBuilder::setTransitions(
             {
                 for(const auto& out : outSymbols)
                 {
-                    outs[{fromState, input}].push_back(out);
+                    outs[{fromState, input}].push_back(SymbolTable::intern(out));
                 }
             } else {
                 if (i < outSymbols.size()) { // Ensure that we don't go out of bounds
-                    outs[{fromState, input}].push_back(outSymbols[i]);
+                    outs[{fromState, input}].push_back(SymbolTable::intern(outSymbols[i]));
                 }
             }
         }
@@ -0,0 +1,95 @@
+#include <entity/FrozenTransitions.h>
+#include <algorithm>
+#include <stdexcept>
+
+FrozenTransitions::FrozenTransitions(const std::vector<std::shared_ptr<State>>& states,
+                                     const TransitionsRelation::TransitionMap& transitions) {
+    auto idOf = [this](const std::shared_ptr<State>& state) {
+        auto [it, inserted] = ids.emplace(state.get(), static_cast<StateId>(this->states.size()));
+        if (inserted) {
+            this->states.push_back(state);
+        }
+        return it->second;
+    };
+
+    for (const auto& state : states) {
+        idOf(state);
+    }
+
+    // count edges per state, then place them with a prefix sum
+    std::vector<std::uint32_t> degree;
+    for (const auto& [key, targets] : transitions) {
+        const StateId from = idOf(key.first);
+        for (const auto& target : targets) {
+            idOf(target);
+        }
+        degree.resize(this->states.size(), 0);
+        degree[from] += static_cast<std::uint32_t>(targets.size());
+    }
+    degree.resize(this->states.size(), 0);
+
+    offsets.assign(this->states.size() + 1, 0);
+    for (std::size_t i = 0; i < degree.size(); ++i) {
+        offsets[i + 1] = offsets[i] + degree[i];
+    }
+
+    this->transitions.resize(offsets.back());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& [key, targets] : transitions) {
+        const StateId from = ids.at(key.first.get());
+        for (const auto& target : targets) {
+            this->transitions[cursor[from]++] = Edge{key.second, ids.at(target.get())};
+        }
+    }
+
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        std::sort(this->transitions.begin() + offsets[i], this->transitions.begin() + offsets[i + 1],
+                  [](const Edge& left, const Edge& right) {
+                      if (left.symbol != right.symbol) return left.symbol < right.symbol;
+                      return left.target < right.target;
+                  });
+    }
+}
+
+std::size_t FrozenTransitions::stateCount() const {
+    return states.size();
+}
+
+std::size_t FrozenTransitions::transitionCount() const {
+    return transitions.size();
+}
+
+bool FrozenTransitions::hasState(const State* state) const {
+    return ids.find(state) != ids.end();
+}
+
+FrozenTransitions::StateId FrozenTransitions::getId(const State* state) const {
+    auto it = ids.find(state);
+    if (it == ids.end()) {
+        throw std::out_of_range("State does not belong to the frozen automaton");
+    }
+    return it->second;
+}
+
+const std::shared_ptr<State>& FrozenTransitions::getState(StateId id) const {
+    return states.at(id);
+}
+
+FrozenTransitions::EdgeRange FrozenTransitions::edges(StateId state) const {
+    const Edge* data = transitions.data();
+    return {data + offsets[state], data + offsets[state + 1]};
+}
+
+/**
+ * Returns edges of the given state labeled with the given symbol, found with a binary search inside the row
+ */
+FrozenTransitions::EdgeRange FrozenTransitions::move(StateId state, SymbolId input) const {
+    const EdgeRange row = edges(state);
+    const Edge* first = std::lower_bound(row.begin(), row.end(), input, [](const Edge& edge, SymbolId symbol) {
+        return edge.symbol < symbol;
+    });
+    const Edge* last = std::upper_bound(first, row.end(), input, [](SymbolId symbol, const Edge& edge) {
+        return symbol < edge.symbol;
+    });
+    return {first, last};
+}
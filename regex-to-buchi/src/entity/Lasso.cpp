@@ -0,0 +1,14 @@
+#include <entity/Lasso.h>
+
+std::string Lasso::toString() const {
+    std::string result;
+    for (SymbolId symbol : prefix) {
+        result += SymbolTable::getName(symbol);
+    }
+    result += '(';
+    for (SymbolId symbol : cycle) {
+        result += SymbolTable::getName(symbol);
+    }
+    result += ")^";
+    return result;
+}
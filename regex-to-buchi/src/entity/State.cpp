@@ -26,7 +26,9 @@ std::string State::setToString(const std::set<int>& elements, char delimiter) {
 
 State::State(std::vector<std::set<int>> elementaryStates, bool final) :
     elementaryStates{std::move(elementaryStates)},
-    final {final}
+    final {final},
+    elementaryHash{hashElementaryStates(this->elementaryStates)},
+    name{buildName()}
 {}
 
 // generate from elementary State objects
@@ -42,11 +44,14 @@ State::State(const std::vector<std::shared_ptr<State>>& elementaryStates, bool f
     for(const auto& state : elementaryStates) { // check if input state are elementary
         this->elementaryStates.push_back(state->getElementaryStates()[0]);
     }
+    elementaryHash = hashElementaryStates(this->elementaryStates);
+    name = buildName();
 }
 
 
 void State::setSecondaryName(const std::string &secondary_name) {
     secondaryName = secondary_name;
+    name = buildName();
 }
 
 std::string State::getSecondaryName() const {
@@ -62,7 +67,27 @@ void State::setFinal(bool final) {
 }
 
 
-std::string State::getName() const {
+const std::string& State::getName() const {
+    return name;
+}
+
+std::size_t State::getHash() const {
+    return elementaryHash;
+}
+
+std::size_t State::hashElementaryStates(const std::vector<std::set<int>>& elementaryStates) {
+    size_t hashValue = 0;
+    for (const auto& elementaryState : elementaryStates) {
+        // the size separates neighbouring sets, so {1},{2} and {1,2} differ
+        hashValue ^= std::hash<std::size_t>{}(elementaryState.size()) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+        for (int substate : elementaryState) {
+            hashValue ^= std::hash<int>{}(substate) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+        }
+    }
+    return hashValue;
+}
+
+std::string State::buildName() const {
     if(!elementaryStates.empty()) {
         std::string result;
 
@@ -93,9 +118,11 @@ bool State::isElementary() const {
 
 void State::setElementaryStates(const std::vector<std::set<int>>& newElementaryStates) {
     this->elementaryStates = newElementaryStates;
+    this->elementaryHash = hashElementaryStates(this->elementaryStates);
+    this->name = buildName();
 }
 
-std::vector<std::set<int>> State::getElementaryStates() const {
+const std::vector<std::set<int>>& State::getElementaryStates() const {
     return this->elementaryStates;
 }
 
@@ -106,10 +133,7 @@ bool State::operator==(const State& other) const {
 
 namespace std {
     size_t hash<State>::operator()(const State& state) const {
-        size_t hashValue = 0;
-        for (char c : state.getName()) {
-            hashValue ^= std::hash<char>{}(c) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
-        }
+        size_t hashValue = state.getHash();
         hashValue ^= std::hash<bool>{}(state.isFinal());
         return hashValue;
     }
@@ -0,0 +1,85 @@
+#include <entity/StateTupleTable.h>
+#include <algorithm>
+#include <stdexcept>
+
+StateTupleTable::StateTupleTable(std::size_t arity) : arity(arity) {
+    if (arity == 0) {
+        throw std::invalid_argument("Tuple of states must have at least one component");
+    }
+}
+
+std::size_t StateTupleTable::getArity() const {
+    return arity;
+}
+
+std::size_t StateTupleTable::size() const {
+    return hashes.size();
+}
+
+StateTupleTable::TupleId StateTupleTable::intern(const StateId* tuple) {
+    // keep the load factor at most 1/2
+    if (2 * (size() + 1) > slots.size()) {
+        grow();
+    }
+
+    const std::uint32_t tupleHash = hash(tuple);
+    const std::size_t slot = findSlot(tuple, tupleHash);
+    if (slots[slot] != none) {
+        return slots[slot];
+    }
+
+    if (size() >= none) {
+        throw std::length_error("Too many tuples of states");
+    }
+    const auto id = static_cast<TupleId>(size());
+    components.insert(components.end(), tuple, tuple + arity);
+    hashes.push_back(tupleHash);
+    slots[slot] = id;
+    return id;
+}
+
+StateTupleTable::TupleId StateTupleTable::find(const StateId* tuple) const {
+    if (slots.empty()) {
+        return none;
+    }
+    return slots[findSlot(tuple, hash(tuple))];
+}
+
+const StateTupleTable::StateId* StateTupleTable::get(TupleId id) const {
+    return components.data() + static_cast<std::size_t>(id) * arity;
+}
+
+StateTupleTable::StateId StateTupleTable::get(TupleId id, std::size_t position) const {
+    return components[static_cast<std::size_t>(id) * arity + position];
+}
+
+std::uint32_t StateTupleTable::hash(const StateId* tuple) const {
+    std::uint64_t hashValue = arity;
+    for (std::size_t i = 0; i < arity; ++i) {
+        hashValue = (hashValue ^ tuple[i]) * 0x9e3779b97f4a7c15ULL;
+        hashValue ^= hashValue >> 32;
+    }
+    return static_cast<std::uint32_t>(hashValue);
+}
+
+std::size_t StateTupleTable::findSlot(const StateId* tuple, std::uint32_t tupleHash) const {
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t slot = tupleHash & mask;; slot = (slot + 1) & mask) {
+        const TupleId id = slots[slot];
+        if (id == none || (hashes[id] == tupleHash && std::equal(tuple, tuple + arity, get(id)))) {
+            return slot;
+        }
+    }
+}
+
+void StateTupleTable::grow() {
+    slots.assign(std::max<std::size_t>(16, 2 * slots.size()), none);
+    const std::size_t mask = slots.size() - 1;
+    for (TupleId id = 0; id < size(); ++id) {
+        std::size_t slot = hashes[id] & mask;
+        while (slots[slot] != none) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
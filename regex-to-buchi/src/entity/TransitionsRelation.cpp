@@ -8,11 +8,14 @@ size_t PairHash::operator()(const std::pair<std::shared_ptr<T1>, T2>& p) const {
     return hash1 ^ (hash2 << 1); // Combine the two hash values
 }
 
+// Only the key type of the maps is ever hashed, instantiated here as the definition stays out of the header
+template size_t PairHash::operator()(const TransitionsRelation::TransitionKey& p) const;
+
 TransitionsRelation::TransitionsRelation(TransitionMap transitions)
     : transitions(std::move(transitions)) {}
 
 std::vector<std::shared_ptr<State>> TransitionsRelation::move(
-    const std::shared_ptr<State>& current, const std::string& input
+    const std::shared_ptr<State>& current, SymbolId input
     ) const {
     TransitionKey key = std::make_pair(current, input);
     auto it = transitions.find(key);
@@ -26,12 +29,16 @@ std::vector<std::shared_ptr<State>> TransitionsRelation::move(
     return transitions;
 }
 
+TransitionsRelation::TransitionMap& TransitionsRelation::_getTransitions() {
+    return transitions;
+}
+
 /*
     Inserts new mapping (startState, input) -> endState, if it didn't exist.
 */
 void TransitionsRelation::addTransition(
     const std::shared_ptr<State>& startState,
-    const std::string& input,
+    SymbolId input,
     const std::shared_ptr<State>& endState
     ) {
     TransitionKey key = std::make_pair(startState, input);
@@ -5,15 +5,16 @@
 #include <helper/ExamplesHelper.h>
 #include <helper/ConcatenationHelper.h>
 #include <helper/VisualizeHelper.h>
+#include <algo/BuchiComplement.h>
+#include <algo/BuchiIntersection.h>
+#include <algo/Degeneralizer.h>
+#include <algo/EmptinessChecker.h>
+#include <algo/InclusionChecker.h>
+#include <algo/LassoMembership.h>
 
 void ExamplesHelper::processExamples()
 {
-    std::vector<std::vector<std::string>> examples = {
-        example1(),
-        example2(),
-        example3(),
-        example4()
-    };
+    const std::vector<std::vector<std::string>> examples = concatenationExamples();
 
     for (size_t i = 0; i < examples.size(); ++i) {
         std::cout << "\n|-------------------------------- Concatenation Example " << i + 1 << ": "<< "lang1 = " << examples[i][0] << ", lang2 = " << examples[i][1] << " -----------------------------|\n";
@@ -27,6 +28,163 @@ void ExamplesHelper::processExamples()
     std::cout << "\n|------------------------------------------------------------------------------|\n";
 }
 
+void ExamplesHelper::emptinessExamples()
+{
+    const std::vector<std::vector<std::string>> examples = concatenationExamples();
+
+    std::cout << "\n|-------------------------------- Emptiness Examples -----------------------------|\n";
+    for (const auto& example : examples) {
+        auto automaton = ConcatenationHelper::concatenate(example[0], example[1]);
+        const auto lasso = EmptinessChecker(*automaton).findAcceptingLasso();
+        std::cout << "lang1 = " << example[0] << ", lang2 = " << example[1] << ": "
+                  << (lasso ? "accepts " + lasso->toString() : "empty") << '\n';
+    }
+    std::cout << "\n|------------------------------------------------------------------------------|\n";
+}
+
+// Every witness is checked against every example in one batch, a witness is accepted by its own automaton
+// and mostly rejected by the others. Doubling the cycle spells the same word and must not change the answer
+void ExamplesHelper::membershipExamples()
+{
+    const std::vector<std::vector<std::string>> examples = concatenationExamples();
+
+    std::vector<std::unique_ptr<Automaton>> automata;
+    std::vector<Lasso> lassos;
+    for (const auto& example : examples) {
+        automata.push_back(ConcatenationHelper::concatenate(example[0], example[1]));
+        if (const auto lasso = EmptinessChecker(*automata.back()).findAcceptingLasso()) {
+            lassos.push_back(*lasso);
+        }
+    }
+    const size_t witnesses = lassos.size();
+    for (size_t i = 0; i < witnesses; ++i) {
+        Lasso doubled = lassos[i];
+        doubled.cycle.insert(doubled.cycle.end(), lassos[i].cycle.begin(), lassos[i].cycle.end());
+        lassos.push_back(doubled);
+    }
+
+    std::cout << "\n|-------------------------------- Membership Examples -----------------------------|\n";
+    for (size_t i = 0; i < examples.size(); ++i) {
+        const std::vector<bool> accepted = LassoMembership(*automata[i]).acceptsAll(lassos);
+        std::cout << "lang1 = " << examples[i][0] << ", lang2 = " << examples[i][1] << ":\n";
+        for (size_t j = 0; j < witnesses; ++j) {
+            std::cout << "    " << lassos[j].toString() << (accepted[j] ? " accepted" : " rejected");
+            if (accepted[j] != accepted[witnesses + j]) {
+                std::cout << ", but " << lassos[witnesses + j].toString() << " is not";
+            }
+            std::cout << '\n';
+        }
+    }
+    std::cout << "\n|------------------------------------------------------------------------------|\n";
+}
+
+void ExamplesHelper::intersectionExamples()
+{
+    // operands as {lang1, lang2} pairs, the second product is empty: "x|y" then "y(x)^" sees y only finitely often
+    const std::vector<std::vector<std::vector<std::string>>> examples = {
+        {{"(x(x)*y)", "(xy)^"}, {"x(y)*", "(xy)^"}},
+        {{"(x(x)*y)", "(xy)^"}, {"x|y", "y(x)^"}},
+    };
+
+    std::cout << "\n|-------------------------------- Intersection Examples -----------------------------|\n";
+    for (size_t i = 0; i < examples.size(); ++i) {
+        const auto& left = examples[i][0];
+        const auto& right = examples[i][1];
+        auto leftAutomaton = ConcatenationHelper::concatenate(left[0], left[1]);
+        auto rightAutomaton = ConcatenationHelper::concatenate(right[0], right[1]);
+        std::cout << "(" << left[0] << ")(" << left[1] << ") & (" << right[0] << ")(" << right[1] << ")\n";
+
+        BuchiIntersection product(*leftAutomaton, *rightAutomaton);
+        auto generalized = product.toAutomaton();
+        auto classic = Degeneralizer::degeneralize(*generalized);
+        std::cout << "Product states: " << generalized->getStates().size()
+                  << ", degeneralized: " << classic->getStates().size() << '\n';
+        classic->print();
+
+        const auto lasso = EmptinessChecker(*classic).findAcceptingLasso();
+        std::cout << "Intersection " << (lasso ? "accepts " + lasso->toString() : "is empty") << '\n';
+
+        VisualizeHelper::toImage(*classic, "intersection_example_" + std::to_string(i + 1), i);
+    }
+    std::cout << "\n|------------------------------------------------------------------------------|\n";
+}
+
+void ExamplesHelper::generalizedExamples()
+{
+    std::cout << "\n|-------------------------------- Generalized Acceptance Examples -----------------------------|\n";
+    std::vector<std::pair<std::string, std::unique_ptr<Automaton>>> examples;
+
+    // a product keeps the final states of both operands as two acceptance sets
+    auto left = ConcatenationHelper::concatenate("(x(x)*y)", "(xy)^");
+    auto right = ConcatenationHelper::concatenate("x(y)*", "(xy)^");
+    examples.emplace_back("((x(x)*y))((xy)^) & (x(y)*)((xy)^)", BuchiIntersection(*left, *right).toAutomaton());
+
+    // a set containing the final states adds nothing, it is dropped and no counter is needed
+    auto relaxed = ConcatenationHelper::concatenate("a(b|c)", "(c|d)a^");
+    relaxed->addAcceptanceSet(relaxed->getStates());
+    examples.emplace_back("(a(b|c))((c|d)a^) with all states as second set", std::move(relaxed));
+
+    for (const auto& [name, automaton] : examples) {
+        std::cout << name << '\n';
+        const auto lasso = EmptinessChecker(*automaton).findAcceptingLasso();
+        auto classic = Degeneralizer::degeneralize(*automaton);
+        std::cout << "Acceptance sets: " << automaton->getAcceptanceSetCount()
+                  << ", states: " << automaton->getStates().size()
+                  << ", degeneralized: " << classic->getStates().size() << '\n';
+        std::cout << "Checked without degeneralizing: " << (lasso ? "accepts " + lasso->toString() : "empty") << '\n';
+    }
+    std::cout << "\n|------------------------------------------------------------------------------|\n";
+}
+
+void ExamplesHelper::inclusionExamples()
+{
+    // {included, including} as {lang1, lang2} pairs, the second one is the first reversed
+    const std::vector<std::vector<std::vector<std::string>>> examples = {
+        {{"(x(x)*y)", "(xy)^"}, {"x(x|y)*", "(xy)^"}},
+        {{"x(x|y)*", "(xy)^"}, {"(x(x)*y)", "(xy)^"}},
+        {{"x|y", "y(x)^"}, {"x|y", "(x|y)^"}},
+    };
+
+    std::cout << "\n|-------------------------------- Inclusion Examples -----------------------------|\n";
+    for (const auto& example : examples) {
+        const auto& included = example[0];
+        const auto& including = example[1];
+        auto includedAutomaton = ConcatenationHelper::concatenate(included[0], included[1]);
+        auto includingAutomaton = ConcatenationHelper::concatenate(including[0], including[1]);
+        std::cout << "(" << included[0] << ")(" << included[1] << ") <= (" << including[0] << ")(" << including[1]
+                  << ")\n";
+
+        InclusionChecker checker(*includedAutomaton, *includingAutomaton);
+        const auto counterexample = checker.findCounterexample();
+        std::cout << (counterexample ? "Not included, counterexample " + counterexample->toString() : "Included")
+                  << '\n';
+        if (counterexample) {
+            std::cout << "Counterexample in lang of the included: "
+                      << LassoMembership(*includedAutomaton).accepts(*counterexample)
+                      << ", of the including: " << LassoMembership(*includingAutomaton).accepts(*counterexample)
+                      << '\n';
+        }
+
+        // the check generates only the part of the complement it walks through
+        BuchiComplement complement(*includingAutomaton);
+        const auto full = complement.toAutomaton(includingAutomaton->getAlphabet()->getLetters());
+        std::cout << "Complement states generated: " << checker.complementStateCount()
+                  << ", reachable complement: " << full->getStates().size() << '\n';
+    }
+    std::cout << "\n|------------------------------------------------------------------------------|\n";
+}
+
+std::vector<std::vector<std::string>> ExamplesHelper::concatenationExamples()
+{
+    return {
+        example1(),
+        example2(),
+        example3(),
+        example4(),
+        example5()
+    };
+}
+
 std::vector<std::string> ExamplesHelper::example1()
 {
     std::string regex1 = "(x(x)*y)";
@@ -57,4 +215,13 @@ std::vector<std::string> ExamplesHelper::example4()
     std::string regex2 = "z^";
 
     return {regex1, regex2};
-}
\ No newline at end of file
+}
+
+// Duplicate alternatives on the right used to leave transitions without outputs after the two-pole step
+std::vector<std::string> ExamplesHelper::example5()
+{
+    std::string regex1 = "(x)*";
+    std::string regex2 = "((y|y)|yy)(x(yy)*)^";
+
+    return {regex1, regex2};
+}
@@ -36,7 +36,7 @@ void AutomatonVisualizer::visualizeAutomaton(const Automaton& automate, const st
     for (const auto& [key, nextStates] :
         automate.getTransitionsRelation()->getTransitions()) {
         const auto& from = key.first;
-        std::string symbol = key.second;
+        std::string symbol = SymbolTable::getName(key.second);
         const auto fromStates = "\"{" + from->getName() + "}\"";;
         const auto toStates = generateStatesVector(nextStates);
 
@@ -0,0 +1,53 @@
+#ifndef MEALYMINIMIZER_H
+#define MEALYMINIMIZER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/State.h>
+
+/**
+ * Minimization of deterministic Mealy automata (Mohri's algorithm for sequential transducers).
+ *
+ * The automaton is trimmed, then outputs are pushed towards the initial state: every state gives up the longest
+ * common prefix of all outputs it can still produce to its incoming transitions. After that two states are
+ * equivalent exactly when they agree on finality, final output and (input, output, target class) of every edge,
+ * which is refined Moore-style until the classes stop splitting.
+ *
+ * The common prefix of the whole translation has no state to live in, it is prepended to the edges and the final
+ * output of the initial state; if the initial state is entered again it is copied first.
+ * The result translates every accepted input like the source, states are numbered by their class.
+ */
+class MealyMinimizer
+{
+public:
+    // Throws std::invalid_argument if the automaton is not deterministic or has epsilon transitions
+    explicit MealyMinimizer(const Automaton& mealy);
+
+    std::unique_ptr<Automaton> minimize();
+
+private:
+    struct Arc
+    {
+        SymbolId input;
+        std::string output;
+        std::size_t target;
+    };
+
+    const Automaton& mealy;
+    // Useful states only, i.e. reachable from the initial state and reaching a final state, the initial one is 0
+    std::vector<std::vector<Arc>> arcs;
+    std::vector<bool> finals;
+    std::vector<std::string> finalOutputs;
+    std::string initialOutput;
+
+    void collectUsefulStates();
+    void pushOutputs();
+    [[nodiscard]] std::vector<std::size_t> refine() const;
+    [[nodiscard]] std::unique_ptr<Automaton> buildQuotient(const std::vector<std::size_t>& blocks) const;
+};
+
+#endif // MEALYMINIMIZER_H
@@ -0,0 +1,68 @@
+#ifndef SEQUENTIALIZER_H
+#define SEQUENTIALIZER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/State.h>
+
+/**
+ * Determinization of an epsilon-free Mealy automaton with delayed output (Mohri's sequentialization).
+ *
+ * States of the result are sets of (state, residual) pairs: the residual is the part of the output of a run that
+ * is not common to all runs yet and has not been written. A transition writes the longest common prefix of
+ * all continued runs and keeps the rest as residuals, a final state writes its residual as the final output.
+ * Runs that can not reach a final state are dropped first, as they never contribute an output.
+ *
+ * The result maps every accepted input to the same output as the source. Such a deterministic automaton exists
+ * only if the source is functional and has bounded delays (the twins property). Functionality is checked first on
+ * the square of the automaton, and the construction fails with std::runtime_error naming the property that does not
+ * hold: two runs on the same accepted input disagree, or a residual grows past the bound n^2 * (longest output).
+ * With the twins property every delay is already reached on a path without cycles through the n^2 pairs of states.
+ */
+class Sequentializer
+{
+public:
+    explicit Sequentializer(const Automaton& mealy);
+
+    std::unique_ptr<Automaton> sequentialize();
+
+private:
+    using Subset = std::vector<std::pair<std::size_t, std::string>>;  // sorted by state
+
+    struct SubsetHash
+    {
+        std::size_t operator()(const Subset& subset) const;
+    };
+
+    struct Move
+    {
+        SymbolId input;
+        std::size_t target;
+        std::string output;  // residual of the source followed by the output of the edge
+    };
+
+    const Automaton& mealy;
+    std::vector<std::shared_ptr<State>> sourceStates;
+    std::unordered_map<const State*, std::size_t> sourceIds;
+    std::vector<bool> sourceFinal;
+    std::vector<bool> useful;  // a final state is reachable
+    std::size_t maxDelay;
+
+    std::unordered_map<Subset, std::size_t, SubsetHash> subsetIds;
+    std::vector<Subset> subsets;
+    std::vector<std::shared_ptr<State>> states;
+    std::vector<std::size_t> worklist;
+
+    std::size_t idOf(const std::shared_ptr<State>& state);
+    void findUsefulStates();
+    // Throws std::runtime_error if two runs on the same accepted input write different outputs
+    void checkFunctional() const;
+    std::size_t findOrAddSubset(Subset subset);
+};
+
+#endif // SEQUENTIALIZER_H
@@ -5,19 +5,26 @@
 #ifndef ALPHABET_H
 #define ALPHABET_H
 
+#include <memory>
 #include <string>
 #include <vector>
+#include <entity/SymbolTokenizer.h>
 
 class Alphabet
 {
 private:
     std::vector<std::string> letters;
+    mutable std::shared_ptr<const SymbolTokenizer> tokenizer;
 
 public:
     explicit Alphabet(std::vector<std::string> letters);
     [[nodiscard]] std::vector<std::string> getLetters() const;
+    // Mutable access (drops the tokenizer)
     std::vector<std::string>& _getLetters();
     bool hasLetter(const std::string& letter);
+
+    // Builds (or returns the already built) longest-match tokenizer over the letters
+    const SymbolTokenizer& getTokenizer() const;
 };
 
 #endif //ALPHABET_H
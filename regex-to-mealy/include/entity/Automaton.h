@@ -2,8 +2,12 @@
 #define AUTOMATA_H
 
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <entity/Alphabet.h>
+#include <entity/OutputLattice.h>
 #include <entity/State.h>
 #include <entity/TransitionsRelation.h>
 
@@ -13,23 +17,22 @@
 class Automaton
 {
 public:
-    // Define a type alias for the output symbols map
-    using OutputSymbolMap = std::unordered_map<
-        std::pair<std::shared_ptr<State>, std::string>,
-        std::vector<std::string>,
-        PairHash
-    >;
     Automaton();
     Automaton(std::unique_ptr<Alphabet> alphabet,
               std::shared_ptr<State> initialState,
               std::vector<std::shared_ptr<State>> states,
               std::vector<std::shared_ptr<State>> finalStates,
               TransitionsRelation::TransitionMap transitionMap,
-              const OutputSymbolMap& outSymbolsMap = {},
               std::unique_ptr<Alphabet> outAlphabet = nullptr
     );
 
     std::vector<std::string> getAllOutputsByInput(const std::string& input, bool reverse = false);
+    // Outputs of all runs on the input, shared in a (position, state) DAG instead of being expanded.
+    // Throws std::runtime_error if the input is not made of input letters
+    [[nodiscard]] OutputLattice getOutputLattice(const std::string& input) const;
+    // Output of an accepted input, final output included, in one pass over a deterministic automaton;
+    // nullopt if the input is rejected, including input that is not made of input letters
+    [[nodiscard]] std::optional<std::string> translate(const std::string& input) const;
 
     [[nodiscard]] const Alphabet* getOutAlphabet() const;
 
@@ -41,23 +44,17 @@ public:
     [[nodiscard]] const Alphabet* getAlphabet() const;
 
     Alphabet* getOutputAlphabet() const;
-    OutputSymbolMap getOutputFunction() const;
-    void setOutputFunction(const OutputSymbolMap& out);
 
     Alphabet* _getAlphabet() const;
     [[nodiscard]] const State* getInitialState() const;
     [[nodiscard]] std::shared_ptr<State> getInitialStateShared() const;
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getStates() const;
+    std::vector<std::shared_ptr<State>>& _getStates();
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getFinalStates() const;
     [[nodiscard]] const TransitionsRelation* getTransitionsRelation() const;
 
     [[nodiscard]] const std::unordered_map<std::string, std::vector<std::string>> getAutomatonInText() const;
 
-
-    [[nodiscard]] const std::unordered_map<std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>,
-                                           PairHash>&
-    getOutSymbolsRelation() const;
-
     TransitionsRelation* _getTransitionsRelation() const;
 
     // Setters
@@ -70,19 +67,29 @@ public:
     [[nodiscard]] std::shared_ptr<State> findStateBySubstates(const std::set<int>& substates) const;
     [[nodiscard]] bool isDeterministic() const;
 
-    std::vector<std::string> getOutputOfTransition(const std::shared_ptr<State>& current,
-                                                   const std::string& input) const;
+    // Outputs of the edges on input, in the order of the targets returned by TransitionsRelation::move
+    std::vector<SymbolId> getOutputOfTransition(const std::shared_ptr<State>& current, SymbolId input) const;
+
+    // Output written after the whole input when the run stops in the final state, empty unless set
+    [[nodiscard]] SymbolId getFinalOutput(const std::shared_ptr<State>& state) const;
+    [[nodiscard]] const std::unordered_map<std::shared_ptr<State>, SymbolId>& getFinalOutputs() const;
+    void setFinalOutput(const std::shared_ptr<State>& state, SymbolId output);
 
     bool doesAcceptWord(const std::vector<std::string>& word) const;
 
 private:
+    // Splits the input into symbols of the input alphabet, longest letters first
+    [[nodiscard]] std::vector<SymbolId> splitInput(const std::string& input) const;
+    static std::vector<std::pair<SymbolId, TransitionsRelation::EdgeList>> groupByInput(
+        const TransitionsRelation::EdgeList& edges);
+
     std::unique_ptr<Alphabet> alphabet;
     std::unique_ptr<Alphabet> outAlphabet;
     std::shared_ptr<State> initialState;
     std::vector<std::shared_ptr<State>> states;
     std::vector<std::shared_ptr<State>> finalStates;
     std::unique_ptr<TransitionsRelation> transitionsRelation;
-    OutputSymbolMap outSymbolsRelation;
+    std::unordered_map<std::shared_ptr<State>, SymbolId> finalOutputs;
 };
 
 #endif // AUTOMATA_H
@@ -16,15 +16,9 @@ private:
     std::vector<std::shared_ptr<State>> finalStates;
     std::vector<std::string> alphabet;
     std::vector<std::string> outAlphabet;
-    std::unordered_map<
-        std::pair<std::shared_ptr<State>, std::string>, std::vector<std::shared_ptr<State>>, PairHash
-    > transitions;
+    TransitionsRelation::TransitionMap transitions;
     std::shared_ptr<State> initialState;
 
-    std::unordered_map<
-        std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash
-    > outs;
-
     std::shared_ptr<State> getState(int stateId);
 
 public:
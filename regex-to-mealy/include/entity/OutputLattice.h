@@ -0,0 +1,76 @@
+#ifndef OUTPUTLATTICE_H
+#define OUTPUTLATTICE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <entity/State.h>
+#include <entity/SymbolTable.h>
+
+/**
+ * All outputs of a transducer for one input word, kept as a DAG instead of a list of strings.
+ *
+ * Nodes are (position, state) pairs, a node exists once per position no matter how many runs pass through it,
+ * and edges carry the output emitted by the transition. Every path from the root (node 0) to a final node of the
+ * last position spells one output, so the lattice stays linear in input length while the number of outputs may
+ * grow exponentially. Runs that end in a node that is not final are rejected and spell nothing. A final node
+ * carries a final label, which ends every output reaching it.
+ */
+class OutputLattice
+{
+public:
+    struct Node
+    {
+        std::size_t position;
+        std::shared_ptr<State> state;
+        bool final;           // only nodes of the last position can be final
+        SymbolId finalLabel;  // empty unless the node is final
+    };
+
+    struct Edge
+    {
+        std::size_t target;
+        SymbolId label;
+    };
+
+    explicit OutputLattice(std::size_t length);
+
+    // Returns the node of the state at the given position, creating it on first use
+    std::size_t addNode(std::size_t position, const std::shared_ptr<State>& state);
+    void addEdge(std::size_t from, std::size_t to, SymbolId label);
+    // Marks a node of the last position as accepting, the label (e.g. the final output of its state) is
+    // appended to the outputs that end in it
+    void setFinal(std::size_t node, SymbolId label = SymbolTable::empty);
+
+    [[nodiscard]] std::size_t getLength() const;
+    [[nodiscard]] std::size_t nodeCount() const;
+    [[nodiscard]] std::size_t edgeCount() const;
+    [[nodiscard]] const Node& getNode(std::size_t node) const;
+    [[nodiscard]] const std::vector<Edge>& getEdges(std::size_t node) const;
+
+    // Number of outputs counted with multiplicity (saturates at UINT64_MAX)
+    [[nodiscard]] std::uint64_t countOutputs() const;
+    // Some output, if there is any
+    [[nodiscard]] std::optional<std::string> anyOutput() const;
+    // Visits outputs one by one in depth-first order, the visitor returns false to stop
+    void forEachOutput(const std::function<bool(const std::string&)>& visitor) const;
+    // Materializes every output, meant for lattices with few outputs
+    [[nodiscard]] std::vector<std::string> getAllOutputs(bool reverse = false) const;
+
+private:
+    std::size_t length;
+    std::vector<Node> nodes;
+    std::vector<std::vector<Edge>> edges;
+    std::vector<std::unordered_map<const State*, std::size_t>> layers;
+
+    // Paths from every node to a final node, rebuilt after the lattice changes
+    mutable std::vector<std::uint64_t> pathCounts;
+
+    const std::vector<std::uint64_t>& getPathCounts() const;
+};
+
+#endif // OUTPUTLATTICE_H
@@ -11,6 +11,8 @@ private:
     std::set<int> substates;
     bool final;
     std::string secondaryName;
+    std::size_t substateHash;        // structural hash of the substates, kept in sync by every setter
+    std::string name;                // display name, rebuilt by every setter that changes it
 
 public:
     void setSecondaryName(const std::string& secondary_name)
@@ -25,13 +27,16 @@ public:
 
 private:
     [[nodiscard]] static std::string implode(const std::vector<int>& elements, char delimiter);
+    [[nodiscard]] static std::size_t hashSubstates(const std::set<int>& elements);
 
 public:
     explicit State(std::set<int> substates, bool final = false);
 
     [[nodiscard]] bool isFinal() const;
     void setFinal(bool final = true);
-    [[nodiscard]] std::string getName() const;
+    [[nodiscard]] const std::string& getName() const;
+    // Hash of the substates only, std::hash<State> adds the final flag
+    [[nodiscard]] std::size_t getHash() const;
 
     bool isAtomic() const;
     const std::set<int> getSubstates() const;
@@ -0,0 +1,81 @@
+#ifndef STREAMINGTRANSDUCER_H
+#define STREAMINGTRANSDUCER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/SymbolTokenizer.h>
+
+/**
+ * Runs a deterministic Mealy automaton over input that arrives in chunks of any size.
+ *
+ * The automaton is compiled into a dense (state, symbol) table with outputs packed into one string, so a step
+ * is one table lookup and one copy into a fixed buffer that goes to the sink when it fills up and after every chunk.
+ * Between chunks only the current state and the bytes of a letter that is not complete yet are kept.
+ * Outputs are written as soon as their symbol is read, finish() adds the final output of an accepting state
+ * and tells whether the input was accepted.
+ */
+class StreamingTransducer
+{
+public:
+    // Throws std::invalid_argument if the automaton has no initial state or is not deterministic
+    explicit StreamingTransducer(const Automaton& automaton);
+
+    // Reads the chunk and writes the outputs of all symbols completed by it,
+    // throws std::runtime_error on text outside the alphabet or a symbol without a transition
+    void feed(const char* data, std::size_t size, std::ostream& sink);
+    void feed(const std::string& chunk, std::ostream& sink);
+    // Ends the input, flushes the last symbol and the final output and returns whether the run stopped in a final state
+    bool finish(std::ostream& sink);
+    // Feeds the whole stream chunk by chunk and finishes it
+    bool run(std::istream& input, std::ostream& sink, std::size_t chunkSize = 1 << 16);
+    // Back to the initial state, for a new input
+    void reset();
+
+    // Symbols read since the last reset
+    [[nodiscard]] std::uint64_t getSymbolCount() const;
+
+private:
+    struct Step
+    {
+        std::int32_t row;  // first entry of the target's row, -1 if there is no transition
+        std::uint32_t outputOffset;
+        std::uint32_t outputLength;
+    };
+
+    SymbolTokenizer tokenizer;
+    std::vector<std::int32_t> columns;          // indexed by SymbolId, -1 for symbols outside the alphabet
+    std::vector<SymbolId> letters;              // indexed by column
+    std::array<std::int32_t, 256> byteColumns;  // column of each byte that is a letter and starts no longer one
+    std::size_t rowWidth;
+    std::vector<Step> steps;                    // row per state, column per letter
+    std::vector<bool> finals;                   // indexed by row / rowWidth
+    std::vector<Step> finalOutputs;             // indexed by row / rowWidth, only the output is used
+    std::string outputs;
+    std::int32_t initialRow;
+
+    std::int32_t row;                           // row of the current state
+    std::int32_t node;                          // tokenizer node after the scanned part of pending
+    std::string pending;                        // bytes of the letter being matched and of what follows it
+    std::size_t scanned;
+    SymbolId matched;                           // longest letter found so far at the start of pending
+    std::size_t matchedLength;
+    std::uint64_t symbolCount;
+    std::vector<char> buffer;
+    std::size_t buffered;
+    std::ostream* sink;                         // sink of the chunk being read
+
+    std::size_t runBytes(const char* data, std::size_t size, std::size_t position);
+    std::size_t matchAt(const char* data, std::size_t size, std::size_t position);
+    void scan();
+    void takeMatch();
+    void step(std::int32_t column);
+    void flush();
+};
+
+#endif // STREAMINGTRANSDUCER_H
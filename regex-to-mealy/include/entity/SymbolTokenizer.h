@@ -0,0 +1,63 @@
+#ifndef SYMBOLTOKENIZER_H
+#define SYMBOLTOKENIZER_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <entity/SymbolTable.h>
+
+/**
+ * Splits input text into letters of an alphabet by greedy longest match.
+ *
+ * Letters are stored in a trie with a 256-entry child table per node, so one pass over the input
+ * reads every character once per match attempt and no substring is created. Letters may have any length,
+ * matches are reported as interned symbol ids.
+ */
+class SymbolTokenizer
+{
+public:
+    explicit SymbolTokenizer(const std::vector<std::string>& letters);
+
+    // Length of the longest letter starting at position (0 if there is none), its symbol goes to letter
+    std::size_t match(const std::string& input, std::size_t position, SymbolId& letter) const;
+    // Symbols of letters that make up the input, throws std::runtime_error if some part is not a letter
+    [[nodiscard]] std::vector<SymbolId> tokenize(const std::string& input) const;
+    // Same, nullopt if some part is not a letter
+    [[nodiscard]] std::optional<std::vector<SymbolId>> tryTokenize(const std::string& input) const;
+
+    // Step by step matching for input that arrives in pieces, walks start at root.
+    // Defined here as they run once per input byte
+    static constexpr std::int32_t root = 0;
+    // Child of the node on the character, -1 if no letter continues that way
+    [[nodiscard]] std::int32_t next(std::int32_t node, char c) const
+    {
+        return nodes[node].children[static_cast<unsigned char>(c)];
+    }
+    // Letter ending in the node or SymbolTable::none
+    [[nodiscard]] SymbolId getLetter(std::int32_t node) const
+    {
+        return nodes[node].letter;
+    }
+    // True if no longer letter passes through the node
+    [[nodiscard]] bool isLeaf(std::int32_t node) const
+    {
+        return nodes[node].leaf;
+    }
+
+private:
+    struct Node
+    {
+        std::array<std::int32_t, 256> children;
+        SymbolId letter = SymbolTable::none;  // letter ending in this node
+        bool leaf = true;
+    };
+
+    std::vector<Node> nodes;
+
+    // Appends letters while they match, returns the position of the first character that starts none
+    std::size_t split(const std::string& input, std::vector<SymbolId>& letters) const;
+};
+
+#endif // SYMBOLTOKENIZER_H
@@ -2,38 +2,55 @@
 #define TRANSITION_H
 
 #include <entity/State.h>
+#include <entity/SymbolTable.h>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <utility>
 
-struct PairHash
-{
-    template <class T1, class T2>
-    size_t operator()(const std::pair<std::shared_ptr<T1>, T2>& p) const;
-};
-
+/**
+ * Transitions of a Mealy automaton, stored as edge records grouped by source state.
+ *
+ * Every edge carries its input, output and target together, so a step reads one row of the source state
+ * and outputs can never get out of step with targets.
+ */
 class TransitionsRelation
 {
 public:
-    using TransitionKey = std::pair<std::shared_ptr<State>, std::string>;
-    using TransitionMap = std::unordered_map<TransitionKey, std::vector<std::shared_ptr<State>>, PairHash>;
+    struct Edge
+    {
+        SymbolId input;
+        SymbolId output;
+        std::shared_ptr<State> target;
+    };
+
+    using EdgeList = std::vector<Edge>;
+    using TransitionMap = std::unordered_map<std::shared_ptr<State>, EdgeList>;
 
     explicit TransitionsRelation(TransitionMap transitions);
 
+    // Edges leaving the state in insertion order, empty if there are none
+    [[nodiscard]] const EdgeList& getEdges(const std::shared_ptr<State>& state) const;
+
     std::vector<std::shared_ptr<State>> move(
         const std::shared_ptr<State>& current,
-        const std::string& input) const;
+        SymbolId input) const;
 
     [[nodiscard]] const TransitionMap& getTransitions() const;
+    // Mutable access, lets constructions splice the map instead of copying it
+    TransitionMap& _getTransitions();
 
     void addTransition(
         const std::shared_ptr<State>& startState,
-        const std::string& input,
-        const std::shared_ptr<State>& endState
+        SymbolId input,
+        const std::shared_ptr<State>& endState,
+        SymbolId output = SymbolTable::empty
     );
     void setTransitions(const TransitionMap& pairs);
 
+    // Adds the edge to the row unless the very same edge is already there
+    static void addEdge(EdgeList& edges, const Edge& edge);
+
 private:
     TransitionMap transitions;
 };
@@ -13,6 +13,12 @@ class SynthesisHelper
 public:
     static std::unique_ptr<Automaton> getMealy(const std::string& regex, bool print = false, int i = 0);
     static void examples();
+    // Deterministic machines read in chunks that split letters, checked against translate()
+    static void streamingExamples();
+    // Nondeterministic machines turned deterministic with delayed output, or reported as not sequential
+    static void sequentializationExamples();
+    // Deterministic machines, sequentialized first if needed, minimized and minimized again
+    static void minimizationExamples();
 };
 
 #endif //SYNTHESISHELPER_H
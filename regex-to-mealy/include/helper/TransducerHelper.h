@@ -0,0 +1,35 @@
+#ifndef TRANSDUCERHELPER_H
+#define TRANSDUCERHELPER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <entity/Alphabet.h>
+#include <entity/SymbolTable.h>
+
+/**
+ * Pieces shared by the constructions that rebuild a Mealy automaton (Sequentializer, MealyMinimizer)
+ */
+class TransducerHelper
+{
+public:
+    // Interns the outputs written by the new automaton and collects the non-empty ones for its output alphabet
+    class OutputCollector
+    {
+    public:
+        SymbolId emit(const std::string& output);
+        [[nodiscard]] std::unique_ptr<Alphabet> toAlphabet() const;
+
+    private:
+        std::vector<std::string> letters;
+        std::unordered_set<SymbolId> seen;
+    };
+
+    // States that reach a final state, found backwards from the final states over the predecessor lists
+    static std::vector<bool> findUseful(const std::vector<std::vector<std::size_t>>& predecessors,
+                                        const std::vector<bool>& finals);
+};
+
+#endif //TRANSDUCERHELPER_H
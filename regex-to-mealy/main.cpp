@@ -4,6 +4,9 @@
 int main()
 {
     SynthesisHelper::examples();
+    SynthesisHelper::streamingExamples();
+    SynthesisHelper::sequentializationExamples();
+    SynthesisHelper::minimizationExamples();
 
     // SynthesisHelper::getMealy("regex_should_be_here");
     return 0;
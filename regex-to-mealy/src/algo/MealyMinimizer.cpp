@@ -0,0 +1,335 @@
+#include <algo/MealyMinimizer.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <helper/TransducerHelper.h>
+
+MealyMinimizer::MealyMinimizer(const Automaton& mealy)
+    : mealy(mealy)
+{
+    if (!mealy.isDeterministic())
+    {
+        throw std::invalid_argument("Minimization needs a deterministic automaton");
+    }
+    for (const auto& [from, edges] : mealy.getTransitionsRelation()->getTransitions())
+    {
+        for (const auto& edge : edges)
+        {
+            if (edge.input == SymbolTable::epsilon)
+            {
+                throw std::invalid_argument("Minimization expects an automaton without epsilon transitions");
+            }
+        }
+    }
+}
+
+/**
+ * Numbers the states reachable from the initial state in breadth-first order and keeps those that reach a final
+ * state. If the initial state reaches none, a single state without edges remains
+ */
+void MealyMinimizer::collectUsefulStates()
+{
+    std::unordered_set<const State*> finalSet;
+    for (const auto& state : mealy.getFinalStates())
+    {
+        finalSet.insert(state.get());
+    }
+
+    std::vector<std::shared_ptr<State>> order = {mealy.getInitialStateShared()};
+    std::unordered_map<const State*, std::size_t> ids = {{order.front().get(), 0}};
+    std::vector<std::vector<Arc>> reachableArcs;
+    for (std::size_t current = 0; current < order.size(); ++current)
+    {
+        reachableArcs.emplace_back();
+        for (const auto& edge : mealy.getTransitionsRelation()->getEdges(order[current]))
+        {
+            auto [it, inserted] = ids.emplace(edge.target.get(), order.size());
+            if (inserted)
+            {
+                order.push_back(edge.target);
+            }
+            reachableArcs[current].push_back(Arc{edge.input, SymbolTable::getName(edge.output), it->second});
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> predecessors(order.size());
+    std::vector<bool> finalFlags(order.size(), false);
+    for (std::size_t state = 0; state < order.size(); ++state)
+    {
+        for (const Arc& arc : reachableArcs[state])
+        {
+            predecessors[arc.target].push_back(state);
+        }
+        finalFlags[state] = finalSet.count(order[state].get()) > 0;
+    }
+    const std::vector<bool> useful = TransducerHelper::findUseful(predecessors, finalFlags);
+
+    if (!useful[0])
+    {
+        arcs.assign(1, {});
+        finals.assign(1, false);
+        finalOutputs.assign(1, "");
+        return;
+    }
+
+    std::vector<std::size_t> renumbered(order.size(), 0);
+    std::size_t count = 0;
+    for (std::size_t state = 0; state < order.size(); ++state)
+    {
+        if (useful[state])
+        {
+            renumbered[state] = count++;
+        }
+    }
+
+    arcs.assign(count, {});
+    finals.assign(count, false);
+    finalOutputs.assign(count, "");
+    for (std::size_t state = 0; state < order.size(); ++state)
+    {
+        if (!useful[state])
+        {
+            continue;
+        }
+
+        const std::size_t id = renumbered[state];
+        for (Arc& arc : reachableArcs[state])
+        {
+            if (useful[arc.target])
+            {
+                arc.target = renumbered[arc.target];
+                arcs[id].push_back(std::move(arc));
+            }
+        }
+        std::sort(arcs[id].begin(), arcs[id].end(), [](const Arc& left, const Arc& right) {
+            return left.input < right.input;
+        });
+
+        if (finalFlags[state])
+        {
+            finals[id] = true;
+            finalOutputs[id] = SymbolTable::getName(mealy.getFinalOutput(order[state]));
+        }
+    }
+}
+
+/**
+ * Computes for every state the longest common prefix of the outputs of its accepted continuations
+ * (a greatest fixpoint: prefixes only get shorter while they are recomputed), then moves it onto the incoming edges
+ */
+void MealyMinimizer::pushOutputs()
+{
+    auto meet = [](std::optional<std::string>& into, const std::string& other) {
+        if (!into)
+        {
+            into = other;
+            return;
+        }
+        const std::size_t length = std::min(into->size(), other.size());
+        into->resize(std::mismatch(into->begin(), into->begin() + length, other.begin()).first - into->begin());
+    };
+
+    const std::size_t count = arcs.size();
+    std::vector<std::vector<std::size_t>> predecessors(count);
+    for (std::size_t state = 0; state < count; ++state)
+    {
+        for (const Arc& arc : arcs[state])
+        {
+            predecessors[arc.target].push_back(state);
+        }
+    }
+
+    std::vector<std::optional<std::string>> prefixes(count);
+    std::deque<std::size_t> worklist;
+    std::vector<bool> queued(count, true);
+    for (std::size_t state = 0; state < count; ++state)
+    {
+        worklist.push_back(state);
+    }
+    while (!worklist.empty())
+    {
+        const std::size_t state = worklist.front();
+        worklist.pop_front();
+        queued[state] = false;
+
+        std::optional<std::string> prefix;
+        if (finals[state])
+        {
+            meet(prefix, finalOutputs[state]);
+        }
+        for (const Arc& arc : arcs[state])
+        {
+            if (prefixes[arc.target])
+            {
+                meet(prefix, arc.output + *prefixes[arc.target]);
+            }
+        }
+
+        if (prefix && prefix != prefixes[state])
+        {
+            prefixes[state] = std::move(prefix);
+            for (std::size_t predecessor : predecessors[state])
+            {
+                if (!queued[predecessor])
+                {
+                    queued[predecessor] = true;
+                    worklist.push_back(predecessor);
+                }
+            }
+        }
+    }
+
+    // without a final state to reach nothing is produced, so nothing is pushed either
+    initialOutput = prefixes[0].value_or("");
+    for (std::size_t state = 0; state < count; ++state)
+    {
+        const std::size_t pushed = prefixes[state] ? prefixes[state]->size() : 0;
+        for (Arc& arc : arcs[state])
+        {
+            arc.output = (arc.output + *prefixes[arc.target]).substr(pushed);
+        }
+        if (finals[state])
+        {
+            finalOutputs[state] = finalOutputs[state].substr(pushed);
+        }
+    }
+}
+
+/**
+ * Moore-style refinement: the class of a state is split by the classes of its edge targets until nothing splits.
+ * Classes are numbered by their first state, so the class of the initial state is 0
+ */
+std::vector<std::size_t> MealyMinimizer::refine() const
+{
+    // Pushed outputs are numbered locally, most of them never reach the quotient and the symbol table
+    const std::size_t count = arcs.size();
+    std::unordered_map<std::string, std::uint64_t> numbers;
+    auto number = [&numbers](const std::string& output) {
+        return numbers.emplace(output, numbers.size()).first->second;
+    };
+    std::vector<std::vector<std::uint64_t>> outputIds(count);
+    std::vector<std::uint64_t> finalOutputIds(count);
+    for (std::size_t state = 0; state < count; ++state)
+    {
+        for (const Arc& arc : arcs[state])
+        {
+            outputIds[state].push_back(number(arc.output));
+        }
+        finalOutputIds[state] = number(finalOutputs[state]);
+    }
+
+    std::vector<std::size_t> blocks(count, 0);
+    std::size_t blockCount = 1;
+    std::vector<std::uint64_t> signature;
+    while (true)
+    {
+        std::map<std::vector<std::uint64_t>, std::size_t> ids;
+        std::vector<std::size_t> next(count);
+        for (std::size_t state = 0; state < count; ++state)
+        {
+            signature = {blocks[state], finals[state], finalOutputIds[state]};
+            for (std::size_t i = 0; i < arcs[state].size(); ++i)
+            {
+                signature.push_back(arcs[state][i].input);
+                signature.push_back(outputIds[state][i]);
+                signature.push_back(blocks[arcs[state][i].target]);
+            }
+            next[state] = ids.emplace(signature, ids.size()).first->second;
+        }
+
+        blocks = std::move(next);
+        if (ids.size() == blockCount)
+        {
+            return blocks;
+        }
+        blockCount = ids.size();
+    }
+}
+
+std::unique_ptr<Automaton> MealyMinimizer::buildQuotient(const std::vector<std::size_t>& blocks) const
+{
+    const std::size_t blockCount = *std::max_element(blocks.begin(), blocks.end()) + 1;
+    std::vector<std::size_t> representatives(blockCount, arcs.size());
+    for (std::size_t state = arcs.size(); state-- > 0;)
+    {
+        representatives[blocks[state]] = state;
+    }
+
+    std::vector<std::shared_ptr<State>> states;
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        states.push_back(std::make_shared<State>(std::set<int>{static_cast<int>(block)},
+                                                 finals[representatives[block]]));
+    }
+
+    TransducerHelper::OutputCollector outputs;
+
+    TransitionsRelation::TransitionMap transitions;
+    std::vector<std::pair<std::shared_ptr<State>, SymbolId>> stateOutputs;
+    std::vector<std::shared_ptr<State>> finalStates;
+    auto addRow = [&](const std::shared_ptr<State>& from, std::size_t representative, const std::string& prefix) {
+        for (const Arc& arc : arcs[representative])
+        {
+            TransitionsRelation::addEdge(transitions[from], TransitionsRelation::Edge{
+                arc.input, outputs.emit(prefix + arc.output), states[blocks[arc.target]]});
+        }
+        if (finals[representative])
+        {
+            finalStates.push_back(from);
+            stateOutputs.emplace_back(from, outputs.emit(prefix + finalOutputs[representative]));
+        }
+    };
+
+    // the initial state writes the common prefix of the whole translation, a copy keeps it out of later visits
+    bool reentered = false;
+    for (const auto& row : arcs)
+    {
+        reentered = reentered || std::any_of(row.begin(), row.end(), [&blocks](const Arc& arc) {
+            return blocks[arc.target] == 0;
+        });
+    }
+    std::shared_ptr<State> initialState = states.front();
+    if (!initialOutput.empty() && reentered)
+    {
+        initialState = std::make_shared<State>(std::set<int>{static_cast<int>(blockCount)}, finals[0]);
+        addRow(initialState, 0, initialOutput);
+    }
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        addRow(states[block], representatives[block], block == 0 && initialState == states.front() ? initialOutput : "");
+    }
+    if (initialState != states.front())
+    {
+        states.push_back(initialState);
+    }
+
+    auto result = std::make_unique<Automaton>(std::make_unique<Alphabet>(mealy.getAlphabet()->getLetters()),
+                                              initialState, states, std::move(finalStates), std::move(transitions),
+                                              outputs.toAlphabet());
+    for (const auto& [state, output] : stateOutputs)
+    {
+        result->setFinalOutput(state, output);
+    }
+    return result;
+}
+
+std::unique_ptr<Automaton> MealyMinimizer::minimize()
+{
+    if (!mealy.getInitialStateShared())
+    {
+        return std::make_unique<Automaton>(std::make_unique<Alphabet>(mealy.getAlphabet()->getLetters()), nullptr,
+                                           std::vector<std::shared_ptr<State>>{},
+                                           std::vector<std::shared_ptr<State>>{},
+                                           TransitionsRelation::TransitionMap());
+    }
+
+    arcs.clear();
+    collectUsefulStates();
+    pushOutputs();
+    return buildQuotient(refine());
+}
@@ -6,46 +6,61 @@
 #include <stack>
 
 // Constructor
-RegexToMealy::RegexToMealy(const std::string& regex) : regex(regex), stateCounter(0)
+RegexToMealy::RegexToMealy(const std::string& regex) : regex(regex), position(0), stateCounter(0)
 {
 }
 
+bool RegexToMealy::atEnd() const
+{
+    return position >= regex.size();
+}
+
+// Returns current character without consuming it, '\0' at the end of the input
+char RegexToMealy::peek() const
+{
+    return atEnd() ? '\0' : regex[position];
+}
+
+std::runtime_error RegexToMealy::parseError(const std::string& message) const
+{
+    return std::runtime_error(message + " at position " + std::to_string(position));
+}
+
 std::pair<std::string, std::string> RegexToMealy::parsePair()
 {
-    if (regex.empty() || regex[0] != '[')
+    if (peek() != '[')
     {
-        throw std::runtime_error("Expected '[' at the start of a pair");
+        throw parseError("Expected '[' at the start of a pair");
     }
-    regex = regex.substr(1);
+    ++position;
 
-    size_t slashPos = regex.find('/');
+    size_t slashPos = regex.find('/', position);
     if (slashPos == std::string::npos)
     {
-        throw std::runtime_error("Expected '/' in a pair");
+        throw parseError("Expected '/' in a pair");
     }
 
-    std::string input = regex.substr(0, slashPos);
-    regex = regex.substr(slashPos + 1);
+    std::string input = regex.substr(position, slashPos - position);
+    position = slashPos + 1;
 
-    size_t closePos = regex.find(']');
+    size_t closePos = regex.find(']', position);
     if (closePos == std::string::npos)
     {
-        throw std::runtime_error("Expected ']' at the end of a pair");
+        throw parseError("Expected ']' at the end of a pair");
     }
 
-    std::string output = regex.substr(0, closePos);
-    regex = regex.substr(closePos + 1);
+    std::string output = regex.substr(position, closePos - position);
+    position = closePos + 1;
 
-    //return '(' + input + ',' + output + ')';
     return {input, output};
 }
 
 std::unique_ptr<Automaton> RegexToMealy::parseExpression()
 {
     auto result = parseTerm();
-    while (!regex.empty() && regex[0] == '|')
+    while (!atEnd() && peek() == '|')
     {
-        regex = regex.substr(1);
+        ++position;
         auto right = parseTerm();
         result = handleDisjunction(std::move(result), std::move(right));
     }
@@ -55,7 +70,7 @@ std::unique_ptr<Automaton> RegexToMealy::parseExpression()
 std::unique_ptr<Automaton> RegexToMealy::parseTerm()
 {
     auto result = parseFactor();
-    while (!regex.empty() && regex[0] != ')' && regex[0] != '|')
+    while (!atEnd() && peek() != ')' && peek() != '|')
     {
         auto right = parseFactor();
         result = handleConcatenation(std::move(result), std::move(right));
@@ -66,29 +81,24 @@ std::unique_ptr<Automaton> RegexToMealy::parseTerm()
 std::unique_ptr<Automaton> RegexToMealy::parseFactor()
 {
     std::unique_ptr<Automaton> result;
-    // if (regex.empty()) {
-    //     return handleEmptyWord();
-    // }
 
-    if (regex.substr(0, 3) == "EPS")
+    if (regex.compare(position, 3, "EPS") == 0)
     {
-        regex = regex.substr(3);
+        position += 3;
         return handleEmptyWord();
     }
 
-    char c = regex[0];
-
-    if (c == '(')
+    if (peek() == '(')
     {
-        regex = regex.substr(1);
+        ++position;
         result = parseExpression();
-        if (regex[0] == ')')
+        if (peek() == ')')
         {
-            regex = regex.substr(1);
+            ++position;
         }
         else
         {
-            throw std::runtime_error("Mismatched parentheses");
+            throw parseError("Mismatched parentheses");
         }
     }
     else
@@ -97,10 +107,10 @@ std::unique_ptr<Automaton> RegexToMealy::parseFactor()
         result = handleElementaryLanguage(input, output);
     }
 
-    while (!regex.empty() && regex[0] == '*')
+    while (!atEnd() && peek() == '*')
     {
         result = handleKleeneStar(std::move(result));
-        regex = regex.substr(1);
+        ++position;
     }
 
     return result;
@@ -114,56 +124,72 @@ std::shared_ptr<State> RegexToMealy::createState(bool isFinal)
 
 void RegexToMealy::addTransition(TransitionsRelation::TransitionMap& transitions,
                                  const std::shared_ptr<State>& from,
-                                 const std::string& symbol,
+                                 SymbolId symbol,
                                  const std::shared_ptr<State>& to,
-                                 Automaton::OutputSymbolMap& outs,
-                                 const std::string& out
+                                 SymbolId out
 )
 {
-    TransitionsRelation::TransitionKey key = std::make_pair(from, symbol);
-    auto it = transitions.find(key);
-    if (it != transitions.end())
+    TransitionsRelation::addEdge(transitions[from], {symbol, out, to});
+}
+
+void RegexToMealy::mergeAlphabets(Automaton& into, const Automaton& from)
+{
+    auto& letters = into._getAlphabet()->_getLetters();
+    for (const std::string& c : from.getAlphabet()->getLetters())
     {
-        if (std::find(it->second.begin(), it->second.end(), to) == it->second.end())
+        if (std::find(letters.begin(), letters.end(), c) == letters.end())
         {
-            it->second.push_back(to);
+            letters.push_back(c);
         }
     }
-    else
+
+    auto& outLetters = into.getOutputAlphabet()->_getLetters();
+    for (const std::string& c : from.getOutputAlphabet()->_getLetters())
     {
-        transitions.insert({key, {to}});
+        if (std::find(outLetters.begin(), outLetters.end(), c) == outLetters.end())
+        {
+            outLetters.push_back(c);
+        }
     }
-
-    outs[key].push_back(out);
 }
 
-std::pair<std::unique_ptr<Alphabet>, std::unique_ptr<Alphabet>> RegexToMealy::mergeAlphabets(
-    const std::unique_ptr<Automaton>& left, const std::unique_ptr<Automaton>& right
-)
+/**
+ * Moves transitions of from into into. Operands never share states, so rows of the smaller map
+ * are spliced into the larger one instead of being copied edge by edge.
+ */
+void RegexToMealy::spliceTransitions(Automaton& into, Automaton& from)
 {
-    auto newAlphabet = std::make_unique<Alphabet>(left->_getAlphabet()->_getLetters());
-    auto& newAlphabetLetters = newAlphabet->_getLetters();
-    const auto& rightAlphabetLetters = right->_getAlphabet()->_getLetters();
-    for (const std::string& c : rightAlphabetLetters)
+    auto& transitions = into._getTransitionsRelation()->_getTransitions();
+    auto& fromTransitions = from._getTransitionsRelation()->_getTransitions();
+
+    if (transitions.size() < fromTransitions.size())
     {
-        if (std::find(newAlphabetLetters.begin(), newAlphabetLetters.end(), c) == newAlphabetLetters.end())
-        {
-            newAlphabetLetters.push_back(c);
-        }
+        transitions.swap(fromTransitions);
     }
+    transitions.merge(fromTransitions);
 
-    auto newOutAlphabet = std::make_unique<Alphabet>(left->getOutputAlphabet()->_getLetters());
-    auto& newOutAlphabetLetters = newOutAlphabet->_getLetters();
-    const auto& rightOutAlphabetLetters = right->getOutputAlphabet()->_getLetters();
-    for (const std::string& c : rightOutAlphabetLetters)
+    // rows of states present in both automata stay behind
+    for (const auto& [state, edges] : fromTransitions)
     {
-        if (std::find(newOutAlphabetLetters.begin(), newOutAlphabetLetters.end(), c) == newOutAlphabetLetters.end())
+        for (const auto& edge : edges)
         {
-            newOutAlphabetLetters.push_back(c);
+            addTransition(transitions, state, edge.input, edge.target, edge.output);
         }
     }
+    fromTransitions.clear();
+}
 
-    return std::make_pair(std::move(newAlphabet), std::move(newOutAlphabet));
+// Moves states of from into into, the smaller vector is appended to the larger one (so the order is not kept)
+void RegexToMealy::spliceStates(Automaton& into, Automaton& from)
+{
+    auto& states = into._getStates();
+    auto& fromStates = from._getStates();
+    if (states.size() < fromStates.size())
+    {
+        states.swap(fromStates);
+    }
+    states.insert(states.end(), std::make_move_iterator(fromStates.begin()), std::make_move_iterator(fromStates.end()));
+    fromStates.clear();
 }
 
 std::unique_ptr<Automaton> RegexToMealy::handleElementaryLanguage(
@@ -173,8 +199,7 @@ std::unique_ptr<Automaton> RegexToMealy::handleElementaryLanguage(
     auto initialState = createState();
     auto finalState = createState(true);
     TransitionsRelation::TransitionMap transitions;
-    Automaton::OutputSymbolMap outs;
-    addTransition(transitions, initialState, input, finalState, outs, output);
+    addTransition(transitions, initialState, SymbolTable::intern(input), finalState, SymbolTable::intern(output));
 
     return std::make_unique<Automaton>(
         std::make_unique<Alphabet>(std::vector<std::string>{input}),
@@ -182,7 +207,6 @@ std::unique_ptr<Automaton> RegexToMealy::handleElementaryLanguage(
         std::vector<std::shared_ptr<State>>{initialState, finalState},
         std::vector<std::shared_ptr<State>>{finalState},
         transitions,
-        outs,
         std::make_unique<Alphabet>(std::vector<std::string>{output})
     );
 }
@@ -196,7 +220,6 @@ std::unique_ptr<Automaton> RegexToMealy::handleEmptyWord()
         std::vector<std::shared_ptr<State>>{state},
         std::vector<std::shared_ptr<State>>{state},
         TransitionsRelation::TransitionMap(),
-        Automaton::OutputSymbolMap(),
         std::make_unique<Alphabet>(std::vector<std::string>{})
     );
 }
@@ -208,107 +231,64 @@ std::unique_ptr<Automaton> RegexToMealy::handleDisjunction(
     auto newInitialState = createState();
     auto newFinalState = createState(true);
 
-    auto newTransitions = left->getTransitionsRelation()->getTransitions();
-    auto newOutFunction = left->getOutputFunction();
-
-    auto rightOuts = right->getOutputFunction();
-
-    // Add all transitions from right automata
-    for (const auto& [key, value] : right->getTransitionsRelation()->getTransitions())
-    {
-        int counter = 0;
-        for (const auto& toState : value)
-        {
-            addTransition(newTransitions, key.first, key.second, toState,
-                          newOutFunction, rightOuts[key][counter]
-            );
-            counter++;
-        }
-    }
+    // Take over transitions of both automata
+    spliceTransitions(*left, *right);
+    auto& newTransitions = left->_getTransitionsRelation()->_getTransitions();
 
     // Connect new initial state to both left and right initial states
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), left->getInitialStateShared(),
-                  newOutFunction, "");
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), right->getInitialStateShared(),
-                  newOutFunction, "");
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, left->getInitialStateShared(),
+                  SymbolTable::empty);
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, right->getInitialStateShared(),
+                  SymbolTable::empty);
 
     // Connect all final states to the new final state
     for (const auto& finalState : left->getFinalStates())
     {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newFinalState,
-                      newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newFinalState,
+                      SymbolTable::empty);
     }
     for (const auto& finalState : right->getFinalStates())
     {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newFinalState,
-                      newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newFinalState,
+                      SymbolTable::empty);
     }
 
     // Merge states
-    auto newStates = left->getStates();
-    newStates.insert(newStates.end(), right->getStates().begin(), right->getStates().end());
-    newStates.push_back(newInitialState);
-    newStates.push_back(newFinalState);
+    spliceStates(*left, *right);
+    left->_getStates().push_back(newInitialState);
+    left->_getStates().push_back(newFinalState);
 
     // Merge alphabets
-    auto [inAlphabet, outAlphabet] = mergeAlphabets(left, right);
+    mergeAlphabets(*left, *right);
 
-    return std::make_unique<Automaton>(
-        std::move(inAlphabet),
-        newInitialState,
-        newStates,
-        std::vector<std::shared_ptr<State>>{newFinalState},
-        newTransitions,
-        newOutFunction,
-        std::move(outAlphabet)
-    );
+    left->setInitialState(newInitialState);
+    left->setFinalStates({newFinalState});
+    return left;
 }
 
 std::unique_ptr<Automaton> RegexToMealy::handleConcatenation(
     std::unique_ptr<Automaton> left, std::unique_ptr<Automaton> right
 )
 {
-    auto newTransitions = left->getTransitionsRelation()->getTransitions();
-
-    auto newOutFunction = left->getOutputFunction();
-    auto rightOuts = right->getOutputFunction();
-
-    // Add all transitions from right automata
-    for (const auto& [key, value] : right->getTransitionsRelation()->getTransitions())
-    {
-        int counter = 0;
-        for (const auto& toState : value)
-        {
-            addTransition(newTransitions, key.first, key.second, toState,
-                          newOutFunction, rightOuts[key][counter]);
-            counter++;
-        }
-    }
+    // Take over transitions of both automata
+    spliceTransitions(*left, *right);
+    auto& newTransitions = left->_getTransitionsRelation()->_getTransitions();
 
     // Connect final states of left to initial state of right
     for (const auto& finalState : left->getFinalStates())
     {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), right->getInitialStateShared(),
-                      newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, right->getInitialStateShared(),
+                      SymbolTable::empty);
     }
 
     // Merge states and set new final states
-    auto newStates = left->getStates();
-    newStates.insert(newStates.end(), right->getStates().begin(), right->getStates().end());
+    spliceStates(*left, *right);
 
     // Merge alphabets
-    auto [inAlphabet, outAlphabet] = mergeAlphabets(left, right);
-
+    mergeAlphabets(*left, *right);
 
-    return std::make_unique<Automaton>(
-        std::move(inAlphabet),
-        left->getInitialStateShared(),
-        newStates,
-        right->getFinalStates(),
-        newTransitions,
-        newOutFunction,
-        std::move(outAlphabet)
-    );
+    left->setFinalStates(right->getFinalStates());
+    return left;
 }
 
 std::unique_ptr<Automaton> RegexToMealy::handleKleeneStar(std::unique_ptr<Automaton> automata)
@@ -316,38 +296,30 @@ std::unique_ptr<Automaton> RegexToMealy::handleKleeneStar(std::unique_ptr<Automa
     auto newInitialState = createState();
     auto newFinalState = createState(true);
 
-    auto newTransitions = automata->getTransitionsRelation()->getTransitions();
-    auto newOutFunction = automata->getOutputFunction();
+    auto& newTransitions = automata->_getTransitionsRelation()->_getTransitions();
 
     // Connect new initial state to new final state and old initial state
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), newFinalState,
-                  newOutFunction, "");
-    addTransition(newTransitions, newInitialState, std::string(1, '\0'), automata->getInitialStateShared(),
-                  newOutFunction, "");
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, newFinalState,
+                  SymbolTable::empty);
+    addTransition(newTransitions, newInitialState, SymbolTable::epsilon, automata->getInitialStateShared(),
+                  SymbolTable::empty);
 
     // Connect old final states to new final state and old initial state
     for (const auto& finalState : automata->getFinalStates())
     {
-        addTransition(newTransitions, finalState, std::string(1, '\0'), newFinalState,
-                      newOutFunction, "");
-        addTransition(newTransitions, finalState, std::string(1, '\0'), automata->getInitialStateShared(),
-                      newOutFunction, "");
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, newFinalState,
+                      SymbolTable::empty);
+        addTransition(newTransitions, finalState, SymbolTable::epsilon, automata->getInitialStateShared(),
+                      SymbolTable::empty);
     }
 
     // Add new states
-    auto newStates = automata->getStates();
-    newStates.push_back(newInitialState);
-    newStates.push_back(newFinalState);
+    automata->_getStates().push_back(newInitialState);
+    automata->_getStates().push_back(newFinalState);
 
-    return std::make_unique<Automaton>(
-        std::make_unique<Alphabet>(automata->_getAlphabet()->_getLetters()),
-        newInitialState,
-        newStates,
-        std::vector<std::shared_ptr<State>>{newFinalState},
-        newTransitions,
-        newOutFunction,
-        std::make_unique<Alphabet>(automata->getOutputAlphabet()->getLetters())
-    );
+    automata->setInitialState(newInitialState);
+    automata->setFinalStates({newFinalState});
+    return automata;
 }
 
 std::set<std::shared_ptr<State>> RegexToMealy::findEpsilonClosure(
@@ -366,17 +338,13 @@ std::set<std::shared_ptr<State>> RegexToMealy::findEpsilonClosure(
         if (closure.find(currentState) != closure.end()) continue;
         closure.insert(currentState);
 
-        for (const auto& [key, value] : transitions)
+        auto row = transitions.find(currentState);
+        if (row == transitions.end()) continue;
+        for (const auto& edge : row->second)
         {
-            if (key.first == currentState && key.second == std::string(1, '\0'))
+            if (edge.input == SymbolTable::epsilon && closure.find(edge.target) == closure.end())
             {
-                for (const auto& nextState : value)
-                {
-                    if (closure.find(nextState) == closure.end())
-                    {
-                        stack.push(nextState);
-                    }
-                }
+                stack.push(edge.target);
             }
         }
     }
@@ -387,8 +355,6 @@ std::set<std::shared_ptr<State>> RegexToMealy::findEpsilonClosure(
 void RegexToMealy::buildNewTransitions(
     const TransitionsRelation::TransitionMap& oldTransitions,
     TransitionsRelation::TransitionMap& newTransitions,
-    Automaton::OutputSymbolMap& oldOutFunction,
-    Automaton::OutputSymbolMap& newOutFunction,
     const std::vector<std::shared_ptr<State>>& states)
 {
     for (const auto& state : states)
@@ -397,18 +363,15 @@ void RegexToMealy::buildNewTransitions(
 
         for (const auto& closureState : closure)
         {
-            for (const auto& [key, value] : oldTransitions)
+            auto row = oldTransitions.find(closureState);
+            if (row == oldTransitions.end()) continue;
+            // Every edge brings its own output along, so no index has to be kept in step with the targets
+            for (const auto& edge : row->second)
             {
-                int counter = 0;
-                if (key.first == closureState && key.second != std::string(1, '\0'))
+                if (edge.input != SymbolTable::epsilon)
                 {
-                    for (const auto& reachableState : value)
-                    {
-                        addTransition(newTransitions, state, key.second, reachableState,
-                                      newOutFunction, oldOutFunction[key][counter]);
-                    }
+                    addTransition(newTransitions, state, edge.input, edge.target, edge.output);
                 }
-                counter++;
             }
         }
     }
@@ -430,17 +393,13 @@ std::set<std::shared_ptr<State>> RegexToMealy::findReachableStates(
         if (reachableStates.find(state) != reachableStates.end()) continue;
         reachableStates.insert(state);
 
-        for (const auto& [key, value] : transitions)
+        auto row = transitions.find(state);
+        if (row == transitions.end()) continue;
+        for (const auto& edge : row->second)
         {
-            if (key.first == state)
+            if (reachableStates.find(edge.target) == reachableStates.end())
             {
-                for (const auto& nextState : value)
-                {
-                    if (reachableStates.find(nextState) == reachableStates.end())
-                    {
-                        stack.push(nextState);
-                    }
-                }
+                stack.push(edge.target);
             }
         }
     }
@@ -452,18 +411,16 @@ std::set<std::shared_ptr<State>> RegexToMealy::findReachableStates(
 void RegexToMealy::removeEpsilonTransitions(std::unique_ptr<Automaton>& automata)
 {
     // Get current transitions, states, initial and final states
-    auto oldTransitions = automata->getTransitionsRelation()->getTransitions();
-    auto oldOutFunction = automata->getOutputFunction();
+    const auto& oldTransitions = automata->getTransitionsRelation()->getTransitions();
     auto states = automata->getStates();
     auto initialState = automata->getInitialStateShared();
     auto finalStates = automata->getFinalStates();
 
     // New transition map after removing epsilon transitions
     TransitionsRelation::TransitionMap newTransitions;
-    Automaton::OutputSymbolMap newOutFunction;
 
     // Build transitions for each state considering epsilon closures
-    buildNewTransitions(oldTransitions, newTransitions, oldOutFunction, newOutFunction, states);
+    buildNewTransitions(oldTransitions, newTransitions, states);
 
     // Find new final states by checking if any state in its epsilon closure is a final state
     std::set<std::shared_ptr<State>> newFinalStates;
@@ -485,21 +442,21 @@ void RegexToMealy::removeEpsilonTransitions(std::unique_ptr<Automaton>& automata
 
     // Filter out unreachable transitions and states
     TransitionsRelation::TransitionMap finalTransitions;
-    for (const auto& [key, value] : newTransitions)
+    for (auto& [state, edges] : newTransitions)
     {
-        if (reachableStates.find(key.first) != reachableStates.end())
+        if (reachableStates.find(state) != reachableStates.end())
         {
-            std::vector<std::shared_ptr<State>> reachableTargets;
-            for (const auto& target : value)
+            TransitionsRelation::EdgeList reachableEdges;
+            for (auto& edge : edges)
             {
-                if (reachableStates.find(target) != reachableStates.end())
+                if (reachableStates.find(edge.target) != reachableStates.end())
                 {
-                    reachableTargets.push_back(target); // Add only reachable target states
+                    reachableEdges.push_back(std::move(edge)); // Add only edges to reachable states
                 }
             }
-            if (!reachableTargets.empty())
+            if (!reachableEdges.empty())
             {
-                finalTransitions[key] = reachableTargets; // Update final transitions map
+                finalTransitions[state] = std::move(reachableEdges); // Update final transitions map
             }
         }
     }
@@ -515,15 +472,19 @@ void RegexToMealy::removeEpsilonTransitions(std::unique_ptr<Automaton>& automata
     }
 
     // Update the automata with new transitions, states, and final states
-    automata->_getTransitionsRelation()->setTransitions(finalTransitions);
+    automata->_getTransitionsRelation()->_getTransitions() = std::move(finalTransitions);
     automata->setStates(std::vector<std::shared_ptr<State>>(reachableStates.begin(), reachableStates.end()));
     automata->setFinalStates(finalStatesList);
-    automata->setOutputFunction(newOutFunction);
 }
 
 std::unique_ptr<Automaton> RegexToMealy::convert()
 {
+    position = 0;
     std::unique_ptr<Automaton> nfa = parseExpression();
+    if (!atEnd())
+    {
+        throw parseError(std::string("Unexpected '") + peek() + "'");
+    }
 
     removeEpsilonTransitions(nfa);
 
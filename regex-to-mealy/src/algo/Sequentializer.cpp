@@ -0,0 +1,338 @@
+#include <algo/Sequentializer.h>
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <helper/TransducerHelper.h>
+
+std::size_t Sequentializer::SubsetHash::operator()(const Subset& subset) const
+{
+    std::size_t hashValue = 0;
+    for (const auto& [state, residual] : subset)
+    {
+        hashValue ^= std::hash<std::size_t>{}(state) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+        hashValue ^= std::hash<std::string>{}(residual) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+    }
+    return hashValue;
+}
+
+Sequentializer::Sequentializer(const Automaton& mealy)
+    : mealy(mealy), maxDelay(0)
+{
+    if (mealy.getInitialStateShared())
+    {
+        idOf(mealy.getInitialStateShared());
+    }
+    for (const auto& state : mealy.getStates())
+    {
+        idOf(state);
+    }
+    for (const auto& [from, edges] : mealy.getTransitionsRelation()->getTransitions())
+    {
+        idOf(from);
+        for (const auto& edge : edges)
+        {
+            if (edge.input == SymbolTable::epsilon)
+            {
+                throw std::invalid_argument("Sequentializer expects an automaton without epsilon transitions");
+            }
+            idOf(edge.target);
+        }
+    }
+    for (const auto& state : mealy.getFinalStates())
+    {
+        idOf(state);
+    }
+
+    // the list of final states is authoritative, flags of source states are not kept up to date
+    sourceFinal.assign(sourceStates.size(), false);
+    for (const auto& state : mealy.getFinalStates())
+    {
+        sourceFinal[sourceIds.at(state.get())] = true;
+    }
+    findUsefulStates();
+}
+
+std::size_t Sequentializer::idOf(const std::shared_ptr<State>& state)
+{
+    auto [it, inserted] = sourceIds.emplace(state.get(), sourceStates.size());
+    if (inserted)
+    {
+        sourceStates.push_back(state);
+    }
+    return it->second;
+}
+
+/**
+ * Marks states that reach a final state and bounds the residuals by the delays of their runs
+ */
+void Sequentializer::findUsefulStates()
+{
+    std::vector<std::vector<std::size_t>> predecessors(sourceStates.size());
+    std::size_t longestOutput = 0;
+    for (const auto& [from, edges] : mealy.getTransitionsRelation()->getTransitions())
+    {
+        for (const auto& edge : edges)
+        {
+            predecessors[sourceIds.at(edge.target.get())].push_back(sourceIds.at(from.get()));
+            longestOutput = std::max(longestOutput, SymbolTable::getName(edge.output).size());
+        }
+    }
+
+    useful = TransducerHelper::findUseful(predecessors, sourceFinal);
+
+    const auto usefulCount = static_cast<std::size_t>(std::count(useful.begin(), useful.end(), true));
+    maxDelay = usefulCount * usefulCount * longestOutput;
+}
+
+/**
+ * Functionality test on the square of the automaton (Beal, Carton, Prieur, Sakarovitch): two runs on the same input
+ * are followed as one pair together with their delay, the output one run has written ahead of the other. Restricted
+ * to pairs that reach a pair of final states, the source is functional iff every pair has a single delay, in no
+ * delay both runs are ahead, and runs that stop together write the same final output
+ */
+void Sequentializer::checkFunctional() const
+{
+    struct PairEdge
+    {
+        std::size_t target;
+        std::string left;
+        std::string right;
+    };
+
+    const std::size_t initialId = sourceIds.at(mealy.getInitialState());
+    std::unordered_map<std::size_t, std::size_t> pairIds;
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    auto pairOf = [&](std::size_t left, std::size_t right) {
+        auto [it, inserted] = pairIds.emplace(left * sourceStates.size() + right, pairs.size());
+        if (inserted)
+        {
+            pairs.emplace_back(left, right);
+        }
+        return it->second;
+    };
+
+    pairOf(initialId, initialId);
+    std::vector<std::vector<PairEdge>> pairEdges;
+    for (std::size_t current = 0; current < pairs.size(); ++current)
+    {
+        pairEdges.emplace_back();
+        const auto [left, right] = pairs[current];
+        for (const auto& leftEdge : mealy.getTransitionsRelation()->getEdges(sourceStates[left]))
+        {
+            const std::size_t leftTarget = sourceIds.at(leftEdge.target.get());
+            if (!useful[leftTarget])
+            {
+                continue;
+            }
+            for (const auto& rightEdge : mealy.getTransitionsRelation()->getEdges(sourceStates[right]))
+            {
+                const std::size_t rightTarget = sourceIds.at(rightEdge.target.get());
+                if (rightEdge.input == leftEdge.input && useful[rightTarget])
+                {
+                    const std::size_t target = pairOf(leftTarget, rightTarget);
+                    pairEdges[current].push_back(PairEdge{target, SymbolTable::getName(leftEdge.output),
+                                                          SymbolTable::getName(rightEdge.output)});
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> predecessors(pairs.size());
+    std::vector<bool> finalPairs(pairs.size(), false);
+    for (std::size_t current = 0; current < pairs.size(); ++current)
+    {
+        for (const PairEdge& edge : pairEdges[current])
+        {
+            predecessors[edge.target].push_back(current);
+        }
+        finalPairs[current] = sourceFinal[pairs[current].first] && sourceFinal[pairs[current].second];
+    }
+    const std::vector<bool> usefulPairs = TransducerHelper::findUseful(predecessors, finalPairs);
+    if (!usefulPairs[0])
+    {
+        return;
+    }
+
+    const std::runtime_error notFunctional("Automaton is not functional, two runs on the same input write different "
+        "outputs, it has no sequential equivalent");
+    // delay of a pair as the outputs still pending on each side, at most one of them is not empty
+    std::vector<std::optional<std::pair<std::string, std::string>>> delays(pairs.size());
+    auto reduce = [&notFunctional](std::string left, std::string right) {
+        const std::size_t common = std::mismatch(left.begin(), left.begin() + std::min(left.size(), right.size()),
+                                                 right.begin()).first - left.begin();
+        left.erase(0, common);
+        right.erase(0, common);
+        if (!left.empty() && !right.empty())
+        {
+            throw notFunctional;
+        }
+        return std::make_pair(std::move(left), std::move(right));
+    };
+
+    delays[0] = std::make_pair(std::string(), std::string());
+    std::vector<std::size_t> queue = {0};
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        const std::size_t current = queue[head];
+        const auto& [leftDelay, rightDelay] = *delays[current];
+        if (finalPairs[current])
+        {
+            const auto [left, right] = pairs[current];
+            if (leftDelay + SymbolTable::getName(mealy.getFinalOutput(sourceStates[left]))
+                != rightDelay + SymbolTable::getName(mealy.getFinalOutput(sourceStates[right])))
+            {
+                throw notFunctional;
+            }
+        }
+
+        for (const PairEdge& edge : pairEdges[current])
+        {
+            if (!usefulPairs[edge.target])
+            {
+                continue;
+            }
+            auto delay = reduce(leftDelay + edge.left, rightDelay + edge.right);
+            if (!delays[edge.target])
+            {
+                delays[edge.target] = std::move(delay);
+                queue.push_back(edge.target);
+            }
+            else if (*delays[edge.target] != delay)
+            {
+                throw notFunctional;
+            }
+        }
+    }
+}
+
+// Returns the id of the state for the given subset, new subsets get the next id and wait in the worklist
+std::size_t Sequentializer::findOrAddSubset(Subset subset)
+{
+    auto it = subsetIds.find(subset);
+    if (it != subsetIds.end())
+    {
+        return it->second;
+    }
+
+    const std::size_t id = subsets.size();
+    const bool isFinal = std::any_of(subset.begin(), subset.end(), [this](const auto& member) {
+        return sourceFinal[member.first];
+    });
+    states.push_back(std::make_shared<State>(std::set<int>{static_cast<int>(id)}, isFinal));
+    subsetIds.emplace(subset, id);
+    subsets.push_back(std::move(subset));
+    worklist.push_back(id);
+    return id;
+}
+
+std::unique_ptr<Automaton> Sequentializer::sequentialize()
+{
+    auto alphabet = std::make_unique<Alphabet>(mealy.getAlphabet()->getLetters());
+    if (!mealy.getInitialStateShared())
+    {
+        return std::make_unique<Automaton>(std::move(alphabet), nullptr, std::vector<std::shared_ptr<State>>{},
+                                           std::vector<std::shared_ptr<State>>{},
+                                           TransitionsRelation::TransitionMap());
+    }
+
+    checkFunctional();
+
+    // an initial state that reaches no final state gives the empty subset, i.e. the empty translation
+    Subset initial;
+    const std::size_t initialId = sourceIds.at(mealy.getInitialState());
+    if (useful[initialId])
+    {
+        initial.emplace_back(initialId, "");
+    }
+    findOrAddSubset(std::move(initial));
+
+    TransitionsRelation::TransitionMap transitions;
+    TransducerHelper::OutputCollector outputs;
+
+    std::vector<Move> moves;
+    // Depth first, so a run whose residual keeps growing hits the bound before its siblings multiply
+    while (!worklist.empty())
+    {
+        const std::size_t current = worklist.back();
+        worklist.pop_back();
+        moves.clear();
+        for (const auto& [state, residual] : subsets[current])
+        {
+            for (const auto& edge : mealy.getTransitionsRelation()->getEdges(sourceStates[state]))
+            {
+                const std::size_t target = sourceIds.at(edge.target.get());
+                if (useful[target])
+                {
+                    moves.push_back(Move{edge.input, target, residual + SymbolTable::getName(edge.output)});
+                }
+            }
+        }
+        std::stable_sort(moves.begin(), moves.end(), [](const Move& left, const Move& right) {
+            return left.input < right.input;
+        });
+
+        const std::shared_ptr<State> from = states[current];
+        for (std::size_t first = 0; first < moves.size();)
+        {
+            std::size_t last = first;
+            std::size_t common = moves[first].output.size();
+            for (; last < moves.size() && moves[last].input == moves[first].input; ++last)
+            {
+                const std::string& output = moves[last].output;
+                common = std::mismatch(output.begin(), output.begin() + std::min(common, output.size()),
+                                       moves[first].output.begin()).first - output.begin();
+            }
+
+            Subset next;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                next.emplace_back(moves[i].target, moves[i].output.substr(common));
+                if (next.back().second.size() > maxDelay)
+                {
+                    throw std::runtime_error("Automaton does not have bounded delays (twins property), "
+                        "it has no sequential equivalent");
+                }
+            }
+            // the source is functional, so runs that meet in one state have the same residual
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+
+            const SymbolId output = outputs.emit(moves[first].output.substr(0, common));
+            const std::size_t target = findOrAddSubset(std::move(next));
+            TransitionsRelation::addEdge(transitions[from], TransitionsRelation::Edge{moves[first].input, output, states[target]});
+            first = last;
+        }
+    }
+
+    std::vector<std::shared_ptr<State>> finalStates;
+    std::vector<std::pair<std::shared_ptr<State>, SymbolId>> finalOutputs;
+    for (std::size_t current = 0; current < subsets.size(); ++current)
+    {
+        if (!states[current]->isFinal())
+        {
+            continue;
+        }
+
+        // every run that stops in a final state writes its residual, as the source is functional they agree
+        std::string finalOutput;
+        for (const auto& [state, residual] : subsets[current])
+        {
+            if (sourceFinal[state])
+            {
+                finalOutput = residual + SymbolTable::getName(mealy.getFinalOutput(sourceStates[state]));
+                break;
+            }
+        }
+
+        finalStates.push_back(states[current]);
+        finalOutputs.emplace_back(states[current], outputs.emit(finalOutput));
+    }
+
+    auto result = std::make_unique<Automaton>(std::move(alphabet), states.front(), states, std::move(finalStates),
+                                              std::move(transitions), outputs.toAlphabet());
+    for (const auto& [state, output] : finalOutputs)
+    {
+        result->setFinalOutput(state, output);
+    }
+    return result;
+}
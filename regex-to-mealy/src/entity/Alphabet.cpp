@@ -9,6 +9,7 @@ Alphabet::Alphabet(std::vector<std::string> letters)
     return letters;
 }
 std::vector<std::string>& Alphabet::_getLetters() {
+    tokenizer.reset();
     return letters;
 }
 
@@ -16,3 +17,12 @@ bool Alphabet::hasLetter(const std::string& letter)
 {
     return std::find(letters.begin(), letters.end(), letter) != letters.end();
 }
+
+const SymbolTokenizer& Alphabet::getTokenizer() const
+{
+    if (!tokenizer)
+    {
+        tokenizer = std::make_shared<const SymbolTokenizer>(letters);
+    }
+    return *tokenizer;
+}
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
 // Default constructor
@@ -19,9 +20,6 @@ Automaton::Automaton(std::unique_ptr<Alphabet> alphabet,
                      std::vector<std::shared_ptr<State>> states,
                      std::vector<std::shared_ptr<State>> finalStates,
                      TransitionsRelation::TransitionMap transitionMap,
-                     const std::unordered_map<
-                         std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash
-                     >& outSymbolsMap,
                      std::unique_ptr<Alphabet> outAlphabet
 )
     : alphabet(std::move(alphabet)),
@@ -29,11 +27,34 @@ Automaton::Automaton(std::unique_ptr<Alphabet> alphabet,
       states(std::move(states)),
       finalStates(std::move(finalStates)),
       transitionsRelation(std::make_unique<TransitionsRelation>(std::move(transitionMap))),
-      outSymbolsRelation(outSymbolsMap),
       outAlphabet(std::move(outAlphabet))
 {
 }
 
+std::vector<SymbolId> Automaton::splitInput(const std::string& input) const
+{
+    return alphabet->getTokenizer().tokenize(input);
+}
+
+// Splits the row into runs of edges with the same input, inputs keep the order of their first edge
+std::vector<std::pair<SymbolId, TransitionsRelation::EdgeList>> Automaton::groupByInput(
+    const TransitionsRelation::EdgeList& edges)
+{
+    std::vector<std::pair<SymbolId, TransitionsRelation::EdgeList>> groups;
+    for (const auto& edge : edges)
+    {
+        auto it = std::find_if(groups.begin(), groups.end(), [&edge](const auto& group) {
+            return group.first == edge.input;
+        });
+        if (it == groups.end())
+        {
+            it = groups.insert(groups.end(), {edge.input, {}});
+        }
+        it->second.push_back(edge);
+    }
+    return groups;
+}
+
 /**
  * Function that returns all possible outputs based on the given input string
  * @param input
@@ -44,33 +65,11 @@ std::vector<std::string> Automaton::getAllOutputsByInput(const std::string& inpu
 {
     // Store multiple current states as we can be in more than one state in a non-deterministic automaton
     std::vector<std::shared_ptr<State>> currentStates = {initialState};
-    size_t size = input.length();
-    int i = 0;
 
     std::vector<std::string> possibleOutputs; // This will store all possible outputs
 
-    while (i < size)
+    for (SymbolId symbol : splitInput(input))
     {
-        // Extract a symbol from the input
-        std::string symbol;
-        int symbolLength = 1;
-
-        // Check for multi-character symbols (assuming max length is 2)
-        for (int len = 1; len <= 2 && i + len <= size; ++len)
-        {
-            std::string potentialSymbol = input.substr(i, len);
-            if (alphabet->hasLetter(potentialSymbol))
-            {
-                symbol = potentialSymbol;
-                symbolLength = len;
-            }
-        }
-
-        if (symbol.empty())
-        {
-            throw std::runtime_error("Current substring is not a part of the input alphabet: " + input.substr(i, 1));
-        }
-
         // Track new states and possible outputs for the next iteration
         std::vector<std::shared_ptr<State>> newStates;
         std::vector<std::string> newOutputs;
@@ -78,31 +77,25 @@ std::vector<std::string> Automaton::getAllOutputsByInput(const std::string& inpu
         // Iterate over all current states (because it's non-deterministic, there may be multiple)
         for (auto& currentState : currentStates)
         {
-            // Get all possible next states and corresponding outputs
-            auto states = transitionsRelation->move(currentState, symbol);
-            auto outs = outSymbolsRelation[{currentState, symbol}];
-
-            // For each state and output pair
-            for (size_t j = 0; j < states.size(); ++j)
+            // Every edge on the symbol gives a next state together with its output
+            for (const auto& edge : transitionsRelation->getEdges(currentState))
             {
-                newStates.push_back(states[j]);
+                if (edge.input != symbol)
+                {
+                    continue;
+                }
+                newStates.push_back(edge.target);
 
                 // Add this output to all previous possible outputs (non-deterministic, so multiple outputs)
                 for (const auto& previousOutput : possibleOutputs)
                 {
-                    for (const auto& out : outs)
-                    {
-                        newOutputs.push_back(previousOutput + out); // Append to all previous outputs
-                    }
+                    newOutputs.push_back(previousOutput + SymbolTable::getName(edge.output));
                 }
 
                 // If we are at the beginning or if this is the first output, initialize the outputs
                 if (possibleOutputs.empty())
                 {
-                    for (const auto& out : outs)
-                    {
-                        newOutputs.push_back(out); // Append to all previous outputs
-                    }
+                    newOutputs.push_back(SymbolTable::getName(edge.output));
                 }
             }
         }
@@ -110,9 +103,6 @@ std::vector<std::string> Automaton::getAllOutputsByInput(const std::string& inpu
         // Update current states and possible outputs
         currentStates = newStates;
         possibleOutputs = newOutputs;
-
-        // Move to the next symbol
-        i += symbolLength;
     }
 
     // Reverse the outputs if the flag is set
@@ -127,6 +117,114 @@ std::vector<std::string> Automaton::getAllOutputsByInput(const std::string& inpu
     return possibleOutputs;
 }
 
+/**
+ * Builds the output lattice of the given input: one node per reachable (position, state), one edge per
+ * (transition, output) pair. Unlike getAllOutputsByInput outputs stay attached to the run that emits them,
+ * and the nodes of runs that stop in a final state carry its final output
+ * @param input
+ * @return
+ */
+OutputLattice Automaton::getOutputLattice(const std::string& input) const
+{
+    const std::vector<SymbolId> symbols = splitInput(input);
+    OutputLattice lattice(symbols.size());
+    if (!initialState)
+    {
+        return lattice;
+    }
+
+    std::vector<std::size_t> currentNodes = {lattice.addNode(0, initialState)};
+    for (size_t position = 0; position < symbols.size() && !currentNodes.empty(); ++position)
+    {
+        std::vector<std::size_t> newNodes;
+        for (std::size_t node : currentNodes)
+        {
+            const std::shared_ptr<State> currentState = lattice.getNode(node).state;
+            const SymbolId symbol = symbols[position];
+            for (const auto& edge : transitionsRelation->getEdges(currentState))
+            {
+                if (edge.input != symbol)
+                {
+                    continue;
+                }
+                const std::size_t before = lattice.nodeCount();
+                const std::size_t next = lattice.addNode(position + 1, edge.target);
+                if (next == before)
+                {
+                    newNodes.push_back(next);
+                }
+                lattice.addEdge(node, next, edge.output);
+            }
+        }
+        currentNodes = std::move(newNodes);
+    }
+
+    // Only runs that stop in a final state yield an output, ending with its final output as in translate()
+    for (std::size_t node : currentNodes)
+    {
+        const std::shared_ptr<State>& state = lattice.getNode(node).state;
+        if (std::find(finalStates.begin(), finalStates.end(), state) != finalStates.end())
+        {
+            lattice.setFinal(node, getFinalOutput(state));
+        }
+    }
+
+    return lattice;
+}
+
+/**
+ * Follows the single run of the input and appends the final output of the state it stops in
+ * @param input
+ * @return
+ */
+std::optional<std::string> Automaton::translate(const std::string& input) const
+{
+    if (!initialState)
+    {
+        return std::nullopt;
+    }
+
+    // text that is not made of input letters has no run
+    const auto symbols = alphabet->getTokenizer().tryTokenize(input);
+    if (!symbols)
+    {
+        return std::nullopt;
+    }
+
+    std::shared_ptr<State> currentState = initialState;
+    std::string output;
+    for (SymbolId symbol : *symbols)
+    {
+        const TransitionsRelation::Edge* next = nullptr;
+        for (const auto& edge : transitionsRelation->getEdges(currentState))
+        {
+            if (edge.input != symbol)
+            {
+                continue;
+            }
+            if (next)
+            {
+                throw std::invalid_argument("Translation needs a deterministic automaton");
+            }
+            next = &edge;
+        }
+
+        if (!next)
+        {
+            return std::nullopt;
+        }
+        output += SymbolTable::getName(next->output);
+        currentState = next->target;
+    }
+
+    if (std::find(finalStates.begin(), finalStates.end(), currentState) == finalStates.end())
+    {
+        return std::nullopt;
+    }
+    output += SymbolTable::getName(getFinalOutput(currentState));
+    return output;
+}
+
 std::unique_ptr<Automaton> Automaton::clone() const
 {
     // Clone the alphabet using the copy constructor or clone method
@@ -143,14 +241,15 @@ std::unique_ptr<Automaton> Automaton::clone() const
     std::unique_ptr<TransitionsRelation> newTransitionsRelation = std::make_unique<TransitionsRelation>(oldTransitions);
 
     // Create a new automaton with the cloned data
-    return std::make_unique<Automaton>(
+    auto copy = std::make_unique<Automaton>(
         std::move(newAlphabet),
         newInitialState,
         newStates,
         newFinalStates,
-        newTransitionsRelation->getTransitions(),
-        outSymbolsRelation
+        newTransitionsRelation->getTransitions()
     );
+    copy->finalOutputs = finalOutputs;
+    return copy;
 }
 
 
@@ -204,47 +303,48 @@ void Automaton::print() const
 
     // Print transitions
     std::cout << "Transitions:\n";
-    for (const auto& [key, nextStates] : transitionsRelation->getTransitions())
+    for (const auto& [fromState, edges] : transitionsRelation->getTransitions())
     {
-        const auto& fromState = key.first;
-        const std::string& input = key.second;
-
-        // Retrieve the corresponding output symbols for the current transition
-        auto outSymbolIt = outSymbolsRelation.find(key);
-
-        // Print the transition in the desired format
-        // std::cout << fromState->getName() << " -- " << input << " --> ";
-        std::cout << fromState->getName() << " -- " << input << " / ";
-
-        // Print the output symbols
-        std::cout << "[";
-        if (outSymbolIt != outSymbolsRelation.end())
+        for (const auto& [symbol, group] : groupByInput(edges))
         {
-            const auto& outSymbols = outSymbolIt->second;
-            for (size_t j = 0; j < outSymbols.size(); ++j)
+            // Print the transition in the desired format
+            // std::cout << fromState->getName() << " -- " << input << " --> ";
+            std::cout << fromState->getName() << " -- " << SymbolTable::getName(symbol) << " / ";
+
+            // Print the output symbols
+            std::cout << "[";
+            for (size_t j = 0; j < group.size(); ++j)
             {
-                std::cout << outSymbols[j];
-                if (j < outSymbols.size() - 1)
+                std::cout << SymbolTable::getName(group[j].output);
+                if (j < group.size() - 1)
                 {
                     std::cout << ", "; // Comma between output symbols
                 }
             }
-        }
-        std::cout << "] --> ";
+            std::cout << "] --> ";
 
-        // Print destination states
-        for (size_t i = 0; i < nextStates.size(); ++i)
-        {
-            std::cout << nextStates[i]->getName();
-            if (i < nextStates.size() - 1)
+            // Print destination states
+            for (size_t i = 0; i < group.size(); ++i)
             {
-                std::cout << ", "; // Comma between states
+                std::cout << group[i].target->getName();
+                if (i < group.size() - 1)
+                {
+                    std::cout << ", "; // Comma between states
+                }
             }
+            std::cout << '\n'; // New line after each transition
         }
-        std::cout << '\n'; // New line after each transition
     }
 
     //print outputs
+    if (!finalOutputs.empty())
+    {
+        std::cout << "Final Outputs:\n";
+        for (const auto& [state, output] : finalOutputs)
+        {
+            std::cout << state->getName() << " / [" << SymbolTable::getName(output) << "]\n";
+        }
+    }
 }
 
 
@@ -289,48 +389,44 @@ void Automaton::printMoore() const
 
     // Print transitions
     std::cout << "Transitions:\n";
-    for (const auto& [key, nextStates] : transitionsRelation->getTransitions())
+    for (const auto& [fromState, edges] : transitionsRelation->getTransitions())
     {
-        const auto& fromState = key.first;
-        const std::string& input = key.second;
-
-        // Retrieve the corresponding output symbols for the current transition
-        auto outSymbolIt = outSymbolsRelation.find(key);
-
-        // Print the transition in the desired format
-        std::cout << fromState->getName() << " -- " << input << " --> ";
-
-
-        // Collect all toState names to print in a single output
-        std::set<std::string> toStateNames; // Use a set to avoid duplicates
-        for (const auto& toState : nextStates)
+        for (const auto& [symbol, group] : groupByInput(edges))
         {
-            toStateNames.insert(toState->getName());
-        }
+            // Print the transition in the desired format
+            std::cout << fromState->getName() << " -- " << SymbolTable::getName(symbol) << " --> ";
 
-        // Print all the state names together
-        for (auto it = toStateNames.begin(); it != toStateNames.end();)
-        {
-            std::cout << *it;
-            ++it;
-            if (it != toStateNames.end())
+            // Collect all toState names to print in a single output
+            std::set<std::string> toStateNames; // Use a set to avoid duplicates
+            for (const auto& edge : group)
             {
-                std::cout << ", "; // Comma between states
+                toStateNames.insert(edge.target->getName());
             }
+
+            // Print all the state names together
+            for (auto it = toStateNames.begin(); it != toStateNames.end();)
+            {
+                std::cout << *it;
+                ++it;
+                if (it != toStateNames.end())
+                {
+                    std::cout << ", "; // Comma between states
+                }
+            }
+            std::cout << '\n'; // New line after each transition
         }
-        std::cout << '\n'; // New line after each transition
     }
 
-
-    std::unordered_map<std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash>
-        outTransitions;
-    outTransitions = getOutSymbolsRelation();
     std::cout << "Output: \n";
 
-    for (const auto& [key, values] : outTransitions)
+    // One line per edge, so every output stays next to the target it belongs to
+    for (const auto& [fromState, edges] : transitionsRelation->getTransitions())
     {
-        //std::string out = outTransitions[std::make_pair(state, std::string())].back();
-        std::cout << key.first->getSecondaryName() << "  -->  " << values.front() << std::endl;
+        for (const auto& edge : edges)
+        {
+            std::cout << fromState->getSecondaryName() << " -- " << SymbolTable::getName(edge.input) << " --> "
+                << edge.target->getName() << "  -->  " << SymbolTable::getName(edge.output) << std::endl;
+        }
     }
 }
 
@@ -343,6 +439,7 @@ const std::unordered_map<std::string, std::vector<std::string>> Automaton::getAu
     std::vector<std::string> finalStates_text;
     std::vector<std::string> states_text;
     std::vector<std::string> transitions_text;
+    std::vector<std::string> finalOutputs_text;
     std::unordered_map<std::string, std::vector<std::string>> out;
 
     for (const std::string& letter : alphabet->getLetters())
@@ -363,40 +460,27 @@ const std::unordered_map<std::string, std::vector<std::string>> Automaton::getAu
     for (const auto& state : states)
         states_text.push_back(state->getName());
 
-    for (const auto& [key, nextStates] : transitionsRelation->getTransitions())
+    // One entry "from/input/output/target" per edge, outputs of a nondeterministic input stay with their targets
+    for (const auto& [fromState, edges] : transitionsRelation->getTransitions())
     {
-        const auto& fromState = key.first;
-        const std::string& input = key.second;
-
-        std::string new_transition{""};
-
-        auto outSymbolIt = outSymbolsRelation.find(key);
-
-        new_transition += fromState->getName() + "/" + input + "/";
-
-        std::vector<std::string> outSymbolsForState;
-        if (outSymbolIt != outSymbolsRelation.end())
-        {
-            outSymbolsForState = outSymbolIt->second;
-        }
-
-        for (size_t j = 0; j < outSymbolsForState.size(); ++j)
+        for (const auto& [symbol, group] : groupByInput(edges))
         {
-            new_transition += outSymbolsForState[j];
-        }
-        new_transition += "/";
-        std::set<std::string> toStateNames;
-        for (const auto& toState : nextStates)
-        {
-            toStateNames.insert(toState->getName());
+            for (const auto& edge : group)
+            {
+                transitions_text.push_back(fromState->getName() + "/" + SymbolTable::getName(symbol) + "/"
+                                           + SymbolTable::getName(edge.output) + "/" + edge.target->getName());
+            }
         }
+    }
 
-        for (auto it = toStateNames.begin(); it != toStateNames.end();)
+    // One entry "state/output" per final state with a final output, as in print()
+    for (const auto& state : finalStates)
+    {
+        const SymbolId finalOutput = getFinalOutput(state);
+        if (finalOutput != SymbolTable::empty)
         {
-            new_transition += *it;
-            ++it;
+            finalOutputs_text.push_back(state->getName() + "/" + SymbolTable::getName(finalOutput));
         }
-        transitions_text.push_back(new_transition);
     }
 
     out["inputAlphabet"] = inputAlphabet_text;
@@ -404,6 +488,7 @@ const std::unordered_map<std::string, std::vector<std::string>> Automaton::getAu
     out["finalStates"] = finalStates_text;
     out["states"] = states_text;
     out["transitions"] = transitions_text;
+    out["finalOutputs"] = finalOutputs_text;
 
     return out;
 }
@@ -430,16 +515,6 @@ Alphabet* Automaton::_getAlphabet() const
     return alphabet.get();
 }
 
-Automaton::OutputSymbolMap Automaton::getOutputFunction() const
-{
-    return outSymbolsRelation;
-}
-
-void Automaton::setOutputFunction(const Automaton::OutputSymbolMap& out)
-{
-    this->outSymbolsRelation = out;
-}
-
 const State* Automaton::getInitialState() const
 {
     return initialState.get();
@@ -450,27 +525,48 @@ const std::vector<std::shared_ptr<State>>& Automaton::getStates() const
     return states;
 }
 
+std::vector<std::shared_ptr<State>>& Automaton::_getStates()
+{
+    return states;
+}
+
 const std::vector<std::shared_ptr<State>>& Automaton::getFinalStates() const
 {
     return finalStates;
 }
 
-const std::unordered_map<std::pair<std::shared_ptr<State>, std::string>, std::vector<std::string>, PairHash
->& Automaton::getOutSymbolsRelation() const
+std::vector<SymbolId> Automaton::getOutputOfTransition(const std::shared_ptr<State>& current, SymbolId input) const
 {
-    return outSymbolsRelation;
+    std::vector<SymbolId> outputs;
+    for (const auto& edge : transitionsRelation->getEdges(current))
+    {
+        if (edge.input == input)
+        {
+            outputs.push_back(edge.output);
+        }
+    }
+    return outputs; // Empty if no such transition exists
 }
 
-std::vector<std::string> Automaton::getOutputOfTransition(const std::shared_ptr<State>& current,
-                                                          const std::string& input) const
+SymbolId Automaton::getFinalOutput(const std::shared_ptr<State>& state) const
 {
-    const std::pair<std::shared_ptr<State>, std::string> key = std::make_pair(current, input);
-    auto it = outSymbolsRelation.find(key);
-    if (it != outSymbolsRelation.end())
+    auto it = finalOutputs.find(state);
+    return it == finalOutputs.end() ? SymbolTable::empty : it->second;
+}
+
+const std::unordered_map<std::shared_ptr<State>, SymbolId>& Automaton::getFinalOutputs() const
+{
+    return finalOutputs;
+}
+
+void Automaton::setFinalOutput(const std::shared_ptr<State>& state, SymbolId output)
+{
+    if (output == SymbolTable::empty)
     {
-        return it->second;
+        finalOutputs.erase(state);
+        return;
     }
-    return {}; // Return an empty vector if no such transition exists
+    finalOutputs[state] = output;
 }
 
 // checks if given word moves automaton from initial state to one of final states
@@ -487,7 +583,10 @@ bool Automaton::doesAcceptWord(const std::vector<std::string>& word) const
 
     for (const std::string& symbol : word)
     {
-        std::vector<std::shared_ptr<State>> nextStates = transitionsRelation->move(currentState, symbol);
+        // symbols that were never interned have no transitions
+        const SymbolId id = SymbolTable::find(symbol);
+        std::vector<std::shared_ptr<State>> nextStates =
+            id == SymbolTable::none ? std::vector<std::shared_ptr<State>>{} : transitionsRelation->move(currentState, id);
         if (nextStates.empty())
         {
             //            throw std::invalid_argument("Automaton does not have all transitions");
@@ -560,15 +659,18 @@ std::shared_ptr<State> Automaton::findStateBySubstates(const std::set<int>& subs
 }
 
 /**
- * Check if each transition has maximum 1 end state
+ * Check if each state has at most one edge per input
  */
 bool Automaton::isDeterministic() const
 {
-    for (const auto& [key, nextStates] : this->transitionsRelation->getTransitions())
+    for (const auto& [state, edges] : this->transitionsRelation->getTransitions())
     {
-        if (nextStates.size() > 1)
+        for (const auto& [symbol, group] : groupByInput(edges))
         {
-            return false;
+            if (group.size() > 1)
+            {
+                return false;
+            }
         }
     }
     return true;
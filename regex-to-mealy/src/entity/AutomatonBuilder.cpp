@@ -66,26 +66,22 @@ AutomatonBuilder& AutomatonBuilder::setTransitions(
 
         for (size_t i = 0; i < size; ++i)
         {
-            const std::string& input = inputs[i];
+            const SymbolId input = SymbolTable::intern(inputs[i]);
+            auto& edges = transitions[fromState];
 
-            // Add transition for the input
-            transitions[{fromState, input}].push_back(toState);
-
-            // Associate output from outSymbols with the current input
-            if (inputs.size() == 1)
+            // A single input takes every output, otherwise inputs and outputs are paired by position
+            if (inputs.size() == 1 && !outSymbols.empty())
             {
                 for (const auto& out : outSymbols)
                 {
-                    outs[{fromState, input}].push_back(out);
+                    TransitionsRelation::addEdge(edges, {input, SymbolTable::intern(out), toState});
                 }
             }
             else
             {
-                if (i < outSymbols.size())
-                {
-                    // Ensure that we don't go out of bounds
-                    outs[{fromState, input}].push_back(outSymbols[i]);
-                }
+                // Ensure that we don't go out of bounds
+                const SymbolId out = i < outSymbols.size() ? SymbolTable::intern(outSymbols[i]) : SymbolTable::empty;
+                TransitionsRelation::addEdge(edges, {input, out, toState});
             }
         }
     }
@@ -101,7 +97,6 @@ Automaton AutomatonBuilder::build()
         states, // Use std::vector<std::shared_ptr<State>>
         finalStates, // Use std::vector<std::shared_ptr<State>>
         std::move(transitions), // Use std::move if transitions is a unique_ptr
-        outs,
         std::make_unique<Alphabet>(outAlphabet)
     };
 }
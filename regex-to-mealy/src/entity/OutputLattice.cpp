@@ -0,0 +1,187 @@
+#include <entity/OutputLattice.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+OutputLattice::OutputLattice(std::size_t length)
+    : length(length), layers(length + 1)
+{
+}
+
+std::size_t OutputLattice::addNode(std::size_t position, const std::shared_ptr<State>& state)
+{
+    if (position > length)
+    {
+        throw std::out_of_range("Lattice position is past the end of the input");
+    }
+
+    auto [it, inserted] = layers[position].emplace(state.get(), nodes.size());
+    if (inserted)
+    {
+        nodes.push_back({position, state, false, SymbolTable::empty});
+        edges.emplace_back();
+        pathCounts.clear();
+    }
+    return it->second;
+}
+
+void OutputLattice::addEdge(std::size_t from, std::size_t to, SymbolId label)
+{
+    if (nodes.at(to).position != nodes.at(from).position + 1)
+    {
+        throw std::invalid_argument("Lattice edges must connect neighbouring positions");
+    }
+
+    edges[from].push_back({to, label});
+    pathCounts.clear();
+}
+
+void OutputLattice::setFinal(std::size_t node, SymbolId label)
+{
+    if (nodes.at(node).position != length)
+    {
+        throw std::invalid_argument("Only nodes of the last position can be final");
+    }
+
+    nodes[node].final = true;
+    nodes[node].finalLabel = label;
+    pathCounts.clear();
+}
+
+std::size_t OutputLattice::getLength() const
+{
+    return length;
+}
+
+std::size_t OutputLattice::nodeCount() const
+{
+    return nodes.size();
+}
+
+std::size_t OutputLattice::edgeCount() const
+{
+    std::size_t count = 0;
+    for (const auto& nodeEdges : edges)
+    {
+        count += nodeEdges.size();
+    }
+    return count;
+}
+
+const OutputLattice::Node& OutputLattice::getNode(std::size_t node) const
+{
+    return nodes.at(node);
+}
+
+const std::vector<OutputLattice::Edge>& OutputLattice::getEdges(std::size_t node) const
+{
+    return edges.at(node);
+}
+
+// Counted layer by layer from the last position, nodes of runs that die early or end in a rejecting node get 0
+const std::vector<std::uint64_t>& OutputLattice::getPathCounts() const
+{
+    if (pathCounts.size() == nodes.size())
+    {
+        return pathCounts;
+    }
+
+    constexpr std::uint64_t limit = std::numeric_limits<std::uint64_t>::max();
+    pathCounts.assign(nodes.size(), 0);
+    for (std::size_t position = length + 1; position-- > 0;)
+    {
+        for (const auto& [state, node] : layers[position])
+        {
+            if (position == length)
+            {
+                pathCounts[node] = nodes[node].final ? 1 : 0;
+                continue;
+            }
+            std::uint64_t count = 0;
+            for (const Edge& edge : edges[node])
+            {
+                count = pathCounts[edge.target] > limit - count ? limit : count + pathCounts[edge.target];
+            }
+            pathCounts[node] = count;
+        }
+    }
+    return pathCounts;
+}
+
+std::uint64_t OutputLattice::countOutputs() const
+{
+    return nodes.empty() ? 0 : getPathCounts()[0];
+}
+
+std::optional<std::string> OutputLattice::anyOutput() const
+{
+    std::optional<std::string> result;
+    forEachOutput([&result](const std::string& output) {
+        result = output;
+        return false;
+    });
+    return result;
+}
+
+/**
+ * Depth-first walk that keeps only the current prefix, edges into nodes without a path to a final node are skipped
+ */
+void OutputLattice::forEachOutput(const std::function<bool(const std::string&)>& visitor) const
+{
+    if (countOutputs() == 0)
+    {
+        return;
+    }
+
+    const auto& counts = getPathCounts();
+    std::string output;
+    // (node, next edge to try, prefix length before entering the node)
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> stack{{0, 0, 0}};
+
+    while (!stack.empty())
+    {
+        auto& [node, next, prefix] = stack.back();
+        if (nodes[node].position == length)
+        {
+            output += SymbolTable::getName(nodes[node].finalLabel);
+            if (!visitor(output))
+            {
+                return;
+            }
+            output.resize(prefix);
+            stack.pop_back();
+            continue;
+        }
+
+        if (next == edges[node].size())
+        {
+            output.resize(prefix);
+            stack.pop_back();
+            continue;
+        }
+
+        const Edge& edge = edges[node][next++];
+        if (counts[edge.target] == 0)
+        {
+            continue;
+        }
+        const std::size_t size = output.size();
+        output += SymbolTable::getName(edge.label);
+        stack.emplace_back(edge.target, 0, size);
+    }
+}
+
+std::vector<std::string> OutputLattice::getAllOutputs(bool reverse) const
+{
+    std::vector<std::string> outputs;
+    forEachOutput([&outputs, reverse](const std::string& output) {
+        outputs.push_back(output);
+        if (reverse)
+        {
+            std::reverse(outputs.back().begin(), outputs.back().end());
+        }
+        return true;
+    });
+    return outputs;
+}
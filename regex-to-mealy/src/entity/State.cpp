@@ -18,8 +18,19 @@ std::string State::implode(const std::vector<int>& elements, char delimiter)
     return result;
 }
 
+std::size_t State::hashSubstates(const std::set<int>& elements)
+{
+    size_t hashValue = 0;
+    for (int element : elements)
+    {
+        hashValue ^= std::hash<int>{}(element) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+    }
+    return hashValue;
+}
+
 State::State(std::set<int> substates, bool final)
-    : substates(std::move(substates)), final(final)
+    : substates(std::move(substates)), final(final), substateHash(hashSubstates(this->substates)),
+      name(implode(std::vector<int>(this->substates.begin(), this->substates.end()), ','))
 {
 }
 
@@ -33,13 +44,18 @@ void State::setFinal(bool final)
     this->final = final;
 }
 
-std::string State::getName() const
+const std::string& State::getName() const
 {
-    if (!substates.empty())
+    if (substates.empty())
     {
-        return implode(std::vector<int>(this->substates.begin(), this->substates.end()), ',');
+        return secondaryName;
     }
-    return secondaryName;
+    return name;
+}
+
+std::size_t State::getHash() const
+{
+    return substateHash;
 }
 
 /**
@@ -53,6 +69,8 @@ bool State::isAtomic() const
 void State::setSubstates(const std::set<int>& newSubstates)
 {
     this->substates = newSubstates;
+    this->substateHash = hashSubstates(this->substates);
+    this->name = implode(std::vector<int>(this->substates.begin(), this->substates.end()), ',');
 }
 
 const std::set<int> State::getSubstates() const
@@ -69,11 +87,7 @@ namespace std
 {
     size_t hash<State>::operator()(const State& state) const
     {
-        size_t hashValue = 0;
-        for (char c : state.getName())
-        {
-            hashValue ^= std::hash<char>{}(c) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
-        }
+        size_t hashValue = state.getHash();
         hashValue ^= std::hash<bool>{}(state.isFinal());
         return hashValue;
     }
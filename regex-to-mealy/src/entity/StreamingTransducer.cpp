@@ -0,0 +1,357 @@
+#include <entity/StreamingTransducer.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+StreamingTransducer::StreamingTransducer(const Automaton& automaton)
+    : tokenizer(automaton.getAlphabet()->getLetters()), rowWidth(0), initialRow(0), sink(nullptr)
+{
+    if (!automaton.getInitialState())
+    {
+        throw std::invalid_argument("Automaton has no initial state");
+    }
+    if (!automaton.isDeterministic())
+    {
+        throw std::invalid_argument("Streaming evaluation needs a deterministic automaton");
+    }
+
+    // letters are interned by the tokenizer, so every one of them gets a column
+    columns.assign(SymbolTable::size(), -1);
+    for (const std::string& letter : automaton.getAlphabet()->getLetters())
+    {
+        const SymbolId symbol = SymbolTable::find(letter);
+        if (columns[symbol] < 0)
+        {
+            columns[symbol] = static_cast<std::int32_t>(letters.size());
+            letters.push_back(symbol);
+        }
+    }
+    rowWidth = std::max<std::size_t>(letters.size(), 1);
+
+    // bytes that can only be read as themselves skip the tokenizer
+    byteColumns.fill(-1);
+    for (int byte = 0; byte < 256; ++byte)
+    {
+        const std::int32_t child = tokenizer.next(SymbolTokenizer::root, static_cast<char>(byte));
+        if (child >= 0 && tokenizer.isLeaf(child) && tokenizer.getLetter(child) != SymbolTable::none)
+        {
+            byteColumns[byte] = columns[tokenizer.getLetter(child)];
+        }
+    }
+
+    std::unordered_map<const State*, std::int32_t> index;
+    auto indexOf = [&index](const std::shared_ptr<State>& state) {
+        return index.emplace(state.get(), static_cast<std::int32_t>(index.size())).first->second;
+    };
+    initialRow = indexOf(automaton.getInitialStateShared()) * static_cast<std::int32_t>(rowWidth);
+    for (const auto& state : automaton.getStates())
+    {
+        indexOf(state);
+    }
+    for (const auto& [from, edges] : automaton.getTransitionsRelation()->getTransitions())
+    {
+        indexOf(from);
+        for (const auto& edge : edges)
+        {
+            indexOf(edge.target);
+        }
+    }
+    for (const auto& state : automaton.getFinalStates())
+    {
+        indexOf(state);
+    }
+
+    std::unordered_map<SymbolId, std::pair<std::uint32_t, std::uint32_t>> packed;
+    std::size_t longestOutput = 0;
+    auto pack = [this, &packed, &longestOutput](SymbolId output) {
+        auto [it, inserted] = packed.emplace(output, std::make_pair(0u, 0u));
+        if (inserted)
+        {
+            const std::string& name = SymbolTable::getName(output);
+            it->second = {static_cast<std::uint32_t>(outputs.size()), static_cast<std::uint32_t>(name.size())};
+            outputs += name;
+            longestOutput = std::max(longestOutput, name.size());
+        }
+        return it->second;
+    };
+
+    steps.assign(index.size() * rowWidth, Step{-1, 0, 0});
+    for (const auto& [from, edges] : automaton.getTransitionsRelation()->getTransitions())
+    {
+        for (const auto& edge : edges)
+        {
+            if (edge.input >= columns.size() || columns[edge.input] < 0)
+            {
+                throw std::invalid_argument("Transition input is not a part of the input alphabet: "
+                    + SymbolTable::getName(edge.input));
+            }
+
+            const auto [offset, length] = pack(edge.output);
+            const std::size_t entry = static_cast<std::size_t>(index.at(from.get())) * rowWidth + columns[edge.input];
+            const auto target = static_cast<std::int32_t>(index.at(edge.target.get()) * rowWidth);
+            steps[entry] = Step{target, offset, length};
+        }
+    }
+
+    finals.assign(index.size(), false);
+    finalOutputs.assign(index.size(), Step{-1, 0, 0});
+    for (const auto& state : automaton.getFinalStates())
+    {
+        const std::int32_t id = index.at(state.get());
+        const auto [offset, length] = pack(automaton.getFinalOutput(state));
+        finals[id] = true;
+        finalOutputs[id] = Step{-1, offset, length};
+    }
+    buffer.resize(std::max<std::size_t>(1 << 16, longestOutput));
+
+    reset();
+}
+
+void StreamingTransducer::feed(const char* data, std::size_t size, std::ostream& sink)
+{
+    this->sink = &sink;
+    try
+    {
+        std::size_t position = 0;
+        // a letter split by the previous chunk is completed byte by byte
+        while (position < size && !pending.empty())
+        {
+            pending.push_back(data[position++]);
+            scan();
+        }
+        // the rest is read in place, only an undecided tail is kept for the next chunk
+        while (position < size)
+        {
+            position = runBytes(data, size, position);
+            if (position == size) break;
+
+            const std::int32_t column = byteColumns[static_cast<unsigned char>(data[position])];
+            if (column >= 0)
+            {
+                // the fast loop stopped on a full buffer or a missing transition, step() deals with both
+                step(column);
+                ++position;
+                continue;
+            }
+
+            const std::size_t length = matchAt(data, size, position);
+            if (length == 0)
+            {
+                pending.assign(data + position, data + size);
+                scan();
+                break;
+            }
+            position += length;
+        }
+    }
+    catch (...)
+    {
+        flush(); // outputs of the symbols before the error still go out
+        throw;
+    }
+    flush();
+}
+
+void StreamingTransducer::feed(const std::string& chunk, std::ostream& sink)
+{
+    feed(chunk.data(), chunk.size(), sink);
+}
+
+bool StreamingTransducer::finish(std::ostream& sink)
+{
+    this->sink = &sink;
+    try
+    {
+        // no more input, so the longest letter found so far is the one
+        while (!pending.empty())
+        {
+            takeMatch();
+            scan();
+        }
+    }
+    catch (...)
+    {
+        flush();
+        throw;
+    }
+
+    const std::size_t state = static_cast<std::size_t>(row) / rowWidth;
+    const Step& last = finalOutputs[state];
+    if (last.outputLength > buffer.size() - buffered)
+    {
+        flush();
+    }
+    std::memcpy(buffer.data() + buffered, outputs.data() + last.outputOffset, last.outputLength);
+    buffered += last.outputLength;
+    flush();
+    return finals[state];
+}
+
+bool StreamingTransducer::run(std::istream& input, std::ostream& sink, std::size_t chunkSize)
+{
+    if (chunkSize == 0)
+    {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+
+    std::vector<char> chunk(chunkSize);
+    while (input.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || input.gcount() > 0)
+    {
+        feed(chunk.data(), static_cast<std::size_t>(input.gcount()), sink);
+    }
+    return finish(sink);
+}
+
+void StreamingTransducer::reset()
+{
+    row = initialRow;
+    node = SymbolTokenizer::root;
+    pending.clear();
+    scanned = 0;
+    matched = SymbolTable::none;
+    matchedLength = 0;
+    symbolCount = 0;
+    buffered = 0;
+}
+
+std::uint64_t StreamingTransducer::getSymbolCount() const
+{
+    return symbolCount;
+}
+
+/**
+ * Steps over single byte letters while they have transitions and their outputs fit into the buffer.
+ * Works on locals, since writes into the buffer could alias members and force reloads on every byte
+ */
+std::size_t StreamingTransducer::runBytes(const char* data, std::size_t size, std::size_t position)
+{
+    const Step* table = steps.data();
+    const char* text = outputs.data();
+    char* out = buffer.data();
+    const std::size_t capacity = buffer.size();
+    const std::size_t start = position;
+    std::int32_t current = row;
+    std::size_t used = buffered;
+
+    while (position < size)
+    {
+        const std::int32_t column = byteColumns[static_cast<unsigned char>(data[position])];
+        if (column < 0) break;
+        const Step& next = table[current + column];
+        if (next.row < 0 || next.outputLength > capacity - used) break;
+
+        std::memcpy(out + used, text + next.outputOffset, next.outputLength);
+        used += next.outputLength;
+        current = next.row;
+        ++position;
+    }
+
+    row = current;
+    buffered = used;
+    symbolCount += position - start;
+    return position;
+}
+
+/**
+ * Reads the longest letter at position straight from the chunk and returns its length,
+ * 0 if the chunk ends while a longer letter is still possible
+ */
+std::size_t StreamingTransducer::matchAt(const char* data, std::size_t size, std::size_t position)
+{
+    std::int32_t at = SymbolTokenizer::root;
+    SymbolId letter = SymbolTable::none;
+    std::size_t length = 0;
+    for (std::size_t i = position; i < size; ++i)
+    {
+        at = tokenizer.next(at, data[i]);
+        if (at < 0) break;
+
+        if (tokenizer.getLetter(at) != SymbolTable::none)
+        {
+            letter = tokenizer.getLetter(at);
+            length = i - position + 1;
+            if (tokenizer.isLeaf(at)) break;
+        }
+        if (i + 1 == size) return 0;
+    }
+
+    if (length == 0)
+    {
+        throw std::runtime_error("Current substring is not a part of the input alphabet: " + std::string(1, data[position]));
+    }
+    step(columns[letter]);
+    return length;
+}
+
+/**
+ * Walks the tokenizer over the unscanned part of pending. A letter is taken once no longer letter can follow,
+ * i.e. when the walk dies or ends in a leaf, so pending never holds more than the longest letter and one byte
+ */
+void StreamingTransducer::scan()
+{
+    while (scanned < pending.size())
+    {
+        const std::int32_t child = tokenizer.next(node, pending[scanned]);
+        if (child < 0)
+        {
+            takeMatch();
+            continue;
+        }
+
+        node = child;
+        ++scanned;
+        const SymbolId letter = tokenizer.getLetter(node);
+        if (letter != SymbolTable::none)
+        {
+            matched = letter;
+            matchedLength = scanned;
+            if (tokenizer.isLeaf(node))
+            {
+                takeMatch();
+            }
+        }
+    }
+}
+
+// Reads the longest letter at the start of pending, matching restarts right after it
+void StreamingTransducer::takeMatch()
+{
+    if (matchedLength == 0)
+    {
+        throw std::runtime_error("Current substring is not a part of the input alphabet: " + pending.substr(0, 1));
+    }
+
+    step(columns[matched]);
+    pending.erase(0, matchedLength);
+    node = SymbolTokenizer::root;
+    scanned = 0;
+    matched = SymbolTable::none;
+    matchedLength = 0;
+}
+
+void StreamingTransducer::step(std::int32_t column)
+{
+    const Step& next = steps[row + column];
+    if (next.row < 0)
+    {
+        throw std::runtime_error("No transition on '" + SymbolTable::getName(letters[column]) + "' after "
+            + std::to_string(symbolCount) + " symbols");
+    }
+
+    if (next.outputLength > buffer.size() - buffered)
+    {
+        flush();
+    }
+    std::memcpy(buffer.data() + buffered, outputs.data() + next.outputOffset, next.outputLength);
+    buffered += next.outputLength;
+    row = next.row;
+    ++symbolCount;
+}
+
+void StreamingTransducer::flush()
+{
+    sink->write(buffer.data(), static_cast<std::streamsize>(buffered));
+    buffered = 0;
+}
@@ -0,0 +1,85 @@
+#include <entity/SymbolTokenizer.h>
+#include <stdexcept>
+
+SymbolTokenizer::SymbolTokenizer(const std::vector<std::string>& letters)
+{
+    nodes.emplace_back();
+    nodes.back().children.fill(-1);
+
+    for (const std::string& letter : letters)
+    {
+        std::size_t node = 0;
+        for (char c : letter)
+        {
+            const auto byte = static_cast<unsigned char>(c);
+            if (nodes[node].children[byte] < 0)
+            {
+                nodes[node].children[byte] = static_cast<std::int32_t>(nodes.size());
+                nodes[node].leaf = false;
+                nodes.emplace_back();
+                nodes.back().children.fill(-1);
+            }
+            node = static_cast<std::size_t>(nodes[node].children[byte]);
+        }
+        // the empty letter is never matched
+        if (node != 0)
+        {
+            nodes[node].letter = SymbolTable::intern(letter);
+        }
+    }
+}
+
+std::size_t SymbolTokenizer::match(const std::string& input, std::size_t position, SymbolId& letter) const
+{
+    std::size_t length = 0;
+    std::int32_t node = 0;
+    for (std::size_t i = position; i < input.size(); ++i)
+    {
+        node = nodes[node].children[static_cast<unsigned char>(input[i])];
+        if (node < 0) break;
+        if (nodes[node].letter != SymbolTable::none)
+        {
+            letter = nodes[node].letter;
+            length = i - position + 1;
+        }
+    }
+    return length;
+}
+
+std::vector<SymbolId> SymbolTokenizer::tokenize(const std::string& input) const
+{
+    std::vector<SymbolId> letters;
+    const std::size_t position = split(input, letters);
+    if (position < input.size())
+    {
+        throw std::runtime_error("Current substring is not a part of the input alphabet: " + input.substr(position, 1));
+    }
+    return letters;
+}
+
+std::optional<std::vector<SymbolId>> SymbolTokenizer::tryTokenize(const std::string& input) const
+{
+    std::vector<SymbolId> letters;
+    if (split(input, letters) < input.size())
+    {
+        return std::nullopt;
+    }
+    return letters;
+}
+
+std::size_t SymbolTokenizer::split(const std::string& input, std::vector<SymbolId>& letters) const
+{
+    std::size_t position = 0;
+    while (position < input.size())
+    {
+        SymbolId letter = SymbolTable::none;
+        const std::size_t length = match(input, position, letter);
+        if (length == 0)
+        {
+            break;
+        }
+        letters.push_back(letter);
+        position += length;
+    }
+    return position;
+}
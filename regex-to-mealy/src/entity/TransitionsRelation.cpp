@@ -1,30 +1,32 @@
 #include <entity/TransitionsRelation.h>
+#include <algorithm>
 #include <utility>
 
-template <class T1, class T2>
-size_t PairHash::operator()(const std::pair<std::shared_ptr<T1>, T2>& p) const
+TransitionsRelation::TransitionsRelation(TransitionMap transitions)
+    : transitions(std::move(transitions))
 {
-    auto hash1 = std::hash<std::shared_ptr<T1>>{}(p.first);
-    auto hash2 = std::hash<T2>{}(p.second);
-    return hash1 ^ (hash2 << 1); // Combine the two hash values
 }
 
-TransitionsRelation::TransitionsRelation(TransitionMap transitions)
-    : transitions(std::move(transitions))
+const TransitionsRelation::EdgeList& TransitionsRelation::getEdges(const std::shared_ptr<State>& state) const
 {
+    static const EdgeList noEdges;
+    auto it = transitions.find(state);
+    return it == transitions.end() ? noEdges : it->second;
 }
 
 std::vector<std::shared_ptr<State>> TransitionsRelation::move(
-    const std::shared_ptr<State>& current, const std::string& input
+    const std::shared_ptr<State>& current, SymbolId input
 ) const
 {
-    TransitionKey key = std::make_pair(current, input);
-    auto it = transitions.find(key);
-    if (it != transitions.end())
+    std::vector<std::shared_ptr<State>> targets;
+    for (const Edge& edge : getEdges(current))
     {
-        return it->second;
+        if (edge.input == input)
+        {
+            targets.push_back(edge.target);
+        }
     }
-    return {}; // Return an empty vector if no transition exists
+    return targets; // Empty if no transition exists
 }
 
 [[nodiscard]] const TransitionsRelation::TransitionMap& TransitionsRelation::getTransitions() const
@@ -32,35 +34,32 @@ std::vector<std::shared_ptr<State>> TransitionsRelation::move(
     return transitions;
 }
 
+TransitionsRelation::TransitionMap& TransitionsRelation::_getTransitions()
+{
+    return transitions;
+}
+
 /*
-    Inserts new mapping (startState, input) -> endState, if it didn't exist.
+    Inserts new edge (startState, input) -> (endState, output), if it didn't exist.
 */
 void TransitionsRelation::addTransition(
     const std::shared_ptr<State>& startState,
-    const std::string& input,
-    const std::shared_ptr<State>& endState
+    SymbolId input,
+    const std::shared_ptr<State>& endState,
+    SymbolId output
 )
 {
-    TransitionKey key = std::make_pair(startState, input);
+    addEdge(transitions[startState], Edge{input, output, endState});
+}
 
-    auto search = transitions.find(key); // pair (key,vector<shared_ptr<State>>)
-    if (search != transitions.end())
-    {
-        // if key mapping exists
-        for (const auto& s : search->second)
-        {
-            // check if transition with same endState is already here
-            if (s->getSubstates() == endState->getSubstates() && s->getSecondaryName() == endState->getSecondaryName())
-            {
-                return; // no actions required, because desired transition is already here
-            }
-        }
-        transitions[key].push_back(endState);
-    }
-    else
+void TransitionsRelation::addEdge(EdgeList& edges, const Edge& edge)
+{
+    const bool present = std::any_of(edges.begin(), edges.end(), [&edge](const Edge& other) {
+        return other.input == edge.input && other.output == edge.output && other.target == edge.target;
+    });
+    if (!present)
     {
-        // there are no transitions from startState on input
-        transitions.insert({key, {endState}});
+        edges.push_back(edge);
     }
 }
 
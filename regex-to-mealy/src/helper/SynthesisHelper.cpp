@@ -1,6 +1,10 @@
 #include <helper/SynthesisHelper.h>
 #include <iostream>
+#include <sstream>
+#include <algo/MealyMinimizer.h>
 #include <algo/RegexToMealy.h>
+#include <algo/Sequentializer.h>
+#include <entity/StreamingTransducer.h>
 #include <helper/VisualizeHelper.h>
 
 std::unique_ptr<Automaton> SynthesisHelper::getMealy(const std::string& regex, bool print, int i)
@@ -37,3 +41,126 @@ void SynthesisHelper::examples()
 
     std::cout << "\n|------------------------------ END: Synthesis Example -----------------------------|\n";
 }
+
+void SynthesisHelper::streamingExamples()
+{
+    std::cout << "\n|------------------------------ START: Streaming Example -----------------------------|\n";
+    // the letters "ab" and "b" overlap, the chunks cut through them
+    std::vector<std::pair<std::string, std::vector<std::string>>> examples = {
+        {"([x/a][y/b])*", {"xyx", "y", "", "xy"}},
+        {"([ab/1]|[b/2])*", {"a", "bb", "a", "bab"}},
+    };
+
+    for (const auto& [regex, chunks] : examples)
+    {
+        auto automate = SynthesisHelper::getMealy(regex);
+        std::cout << "Regex: " << regex << std::endl;
+        if (!automate->isDeterministic())
+        {
+            std::cout << "Not deterministic, streaming skipped\n\n";
+            continue;
+        }
+
+        StreamingTransducer transducer(*automate);
+        std::ostringstream streamed;
+        std::string input;
+        for (const std::string& chunk : chunks)
+        {
+            transducer.feed(chunk, streamed);
+            input += chunk;
+            std::cout << "Chunk: \"" << chunk << "\"\n";
+        }
+        const bool accepted = transducer.finish(streamed);
+
+        const auto translated = automate->translate(input);
+        std::cout << "Streamed output: " << streamed.str() << (accepted ? " (accepted)" : " (rejected)") << std::endl;
+        std::cout << "translate(\"" << input << "\"): " << (translated ? *translated : "rejected") << std::endl;
+        std::cout << "\n";
+    }
+
+    std::cout << "\n|------------------------------ END: Streaming Example -----------------------------|\n";
+}
+
+void SynthesisHelper::sequentializationExamples()
+{
+    std::cout << "\n|------------------------------ START: Sequentialization Example -----------------------------|\n";
+    // the first regex maps "xx" to both "dd" and "ac", so it has no deterministic equivalent; the last one is
+    // functional, but the output of x is known only once the last letter is read (unbounded delay)
+    std::vector<std::pair<std::string, std::vector<std::string>>> examples = {
+        {"([x/a][x/b])*[y/c]|[x/d]*|[x/a][x/c]", {"xx"}},
+        {"([x/a])*[y/b]|[x/a][x/c]", {"xx", "xxy", "y", "xz"}},
+        {"[x/a][y/b]|[x/a][z/c]|[x/d][x/e]", {"xy", "xz", "xx"}},
+        {"([x/a])*[y/b]|([x/c])*[z/d]", {"xxy", "xxz"}},
+    };
+
+    for (int i = 0; i < examples.size(); i++)
+    {
+        const auto& [regex, inputs] = examples[i];
+        auto automate = SynthesisHelper::getMealy(regex);
+        std::cout << "Regex: " << regex << std::endl;
+
+        std::unique_ptr<Automaton> sequential;
+        try
+        {
+            sequential = Sequentializer(*automate).sequentialize();
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cout << "Not sequentializable: " << error.what() << "\n\n";
+            continue;
+        }
+        sequential->print();
+
+        for (const std::string& input : inputs)
+        {
+            const auto translated = sequential->translate(input);
+            std::cout << "translate(\"" << input << "\"): " << (translated ? *translated : "rejected") << std::endl;
+        }
+
+        VisualizeHelper::toImage(*sequential, "sequentialized", i + 1);
+        std::cout << "\n";
+    }
+
+    std::cout << "\n|------------------------------ END: Sequentialization Example -----------------------------|\n";
+}
+
+void SynthesisHelper::minimizationExamples()
+{
+    std::cout << "\n|------------------------------ START: Minimization Example -----------------------------|\n";
+    std::vector<std::pair<std::string, std::vector<std::string>>> examples = {
+        {"([x/a][y/b])*", {"xyxy", "x"}},
+        {"[x/a][x/b][y/c]|[y/a][x/b][y/c]", {"xxy", "yxy"}},
+        {"([x/a][x/a])*|[x/a]([x/a][x/a])*", {"", "xxx"}},
+    };
+
+    for (int i = 0; i < examples.size(); i++)
+    {
+        const auto& [regex, inputs] = examples[i];
+        auto automate = SynthesisHelper::getMealy(regex);
+        std::cout << "Regex: " << regex << std::endl;
+        if (!automate->isDeterministic())
+        {
+            automate = Sequentializer(*automate).sequentialize();
+        }
+
+        auto minimal = MealyMinimizer(*automate).minimize();
+        minimal->print();
+        // a minimal machine has no equivalent states left
+        const auto again = MealyMinimizer(*minimal).minimize();
+        std::cout << "States: " << automate->getStates().size() << " -> " << minimal->getStates().size()
+            << ", minimized again: " << again->getStates().size() << std::endl;
+
+        for (const std::string& input : inputs)
+        {
+            const auto before = automate->translate(input);
+            const auto after = minimal->translate(input);
+            std::cout << "translate(\"" << input << "\"): " << (before ? "\"" + *before + "\"" : "rejected") << " -> "
+                << (after ? "\"" + *after + "\"" : "rejected") << std::endl;
+        }
+
+        VisualizeHelper::toImage(*minimal, "minimized", i + 1);
+        std::cout << "\n";
+    }
+
+    std::cout << "\n|------------------------------ END: Minimization Example -----------------------------|\n";
+}
@@ -0,0 +1,45 @@
+#include <helper/TransducerHelper.h>
+
+SymbolId TransducerHelper::OutputCollector::emit(const std::string& output)
+{
+    const SymbolId id = SymbolTable::intern(output);
+    if (!output.empty() && seen.insert(id).second)
+    {
+        letters.push_back(output);
+    }
+    return id;
+}
+
+std::unique_ptr<Alphabet> TransducerHelper::OutputCollector::toAlphabet() const
+{
+    return std::make_unique<Alphabet>(letters);
+}
+
+std::vector<bool> TransducerHelper::findUseful(const std::vector<std::vector<std::size_t>>& predecessors,
+                                               const std::vector<bool>& finals)
+{
+    std::vector<bool> useful(predecessors.size(), false);
+    std::vector<std::size_t> stack;
+    for (std::size_t state = 0; state < predecessors.size(); ++state)
+    {
+        if (finals[state])
+        {
+            useful[state] = true;
+            stack.push_back(state);
+        }
+    }
+    while (!stack.empty())
+    {
+        const std::size_t state = stack.back();
+        stack.pop_back();
+        for (std::size_t predecessor : predecessors[state])
+        {
+            if (!useful[predecessor])
+            {
+                useful[predecessor] = true;
+                stack.push_back(predecessor);
+            }
+        }
+    }
+    return useful;
+}
@@ -30,36 +30,29 @@ void AutomatonVisualizer::visualizeAutomaton(const Automaton& automate, const st
     dotFile << "node [shape = circle];" << std::endl;
     dotFile << "    qinit -> \"{" << automate.getInitialState()->getName() << "}\";" << std::endl;
 
-    for (const auto& [key, nextStates] :
+    // Accepting states, with the output written when a run stops in them
+    for (const auto& finalState : automate.getFinalStates())
+    {
+        const SymbolId finalOutput = automate.getFinalOutput(finalState);
+        dotFile << "    \"{" << finalState->getName() << "}\" [shape = doublecircle";
+        if (finalOutput != SymbolTable::empty)
+        {
+            dotFile << ", xlabel=\"/ [" << SymbolTable::getName(finalOutput) << "]\"";
+        }
+        dotFile << "];" << std::endl;
+    }
+
+    for (const auto& [from, edges] :
          automate.getTransitionsRelation()->getTransitions())
     {
-        const auto& from = key.first;
-        std::string symbol = key.second;
-        const auto fromStates = "\"{" + from->getName() + "}\"";;
-        const auto toStates = generateStatesVector(nextStates);
+        const auto fromStates = "\"{" + from->getName() + "}\"";
 
-        for (const auto& toState : toStates)
+        // Every edge carries its own output, so each one gets its own arrow
+        for (const auto& edge : edges)
         {
-            // std::cout << "    " << fromStates << " -> " << toState << " [label=\"" << symbol << " / [";
-            dotFile << "    " << fromStates << " -> " << toState << " [label=\"" << symbol << " / [";
-            const auto outSymbolIt = automate.getOutSymbolsRelation().find(key);
-            if (outSymbolIt != automate.getOutSymbolsRelation().end())
-            {
-                const std::set outSymbolsForState(outSymbolIt->second.cbegin(), outSymbolIt->second.cend());
-                auto it = outSymbolsForState.begin();
-                while (it != outSymbolsForState.end())
-                {
-                    dotFile << *it;
-                    ++it;
-                    if (it != outSymbolsForState.end())
-                    {
-                        //std::cout << ", ";
-                        dotFile << ", ";
-                    }
-                }
-            }
-            //std::cout << "]\"];" << std::endl;
-            dotFile << "]\"];" << std::endl;
+            const auto toState = "\"{" + edge.target->getName() + "}\"";
+            dotFile << "    " << fromStates << " -> " << toState << " [label=\"" << SymbolTable::getName(edge.input)
+                << " / [" << SymbolTable::getName(edge.output) << "]\"];" << std::endl;
         }
     }
 
@@ -0,0 +1,45 @@
+#ifndef BITPARALLELMATCHER_H
+#define BITPARALLELMATCHER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <entity/Automaton.h>
+
+/**
+ * Matches words against an epsilon-free automaton without determinizing it (Glushkov-style bit-parallel simulation).
+ *
+ * States are split into positions by their incoming symbol, so the set of active positions after reading c
+ * is Follow(active) & Symbol[c]. Active positions are kept as a multi-word bitset and Follow is precomputed
+ * for every byte-sized chunk of the bitset, so reading one byte costs a few table lookups, ORs and ANDs per word.
+ */
+class BitParallelMatcher
+{
+public:
+    explicit BitParallelMatcher(const Automaton& nfa);
+
+    [[nodiscard]] bool matches(const std::string& word) const;
+    [[nodiscard]] std::size_t positionCount() const;
+
+private:
+    using Mask = std::uint64_t;
+
+    // Chunk tables take chunks * 256 * words masks, above this limit Follow is collected position by position
+    static constexpr std::size_t maxChunkedPositions = 1024;
+
+    std::size_t positions;
+    std::size_t words;
+    bool chunked;
+    bool initialFinal;
+
+    std::vector<Mask> initialFollow;  // positions reachable from the initial state with one symbol
+    std::vector<Mask> follow;         // words per position
+    std::vector<Mask> chunkFollow;    // words per (chunk, byte value)
+    std::vector<Mask> symbolMasks;    // words per symbol, positions entered by that symbol
+    std::vector<Mask> finalMask;
+
+    void buildChunkTables();
+    void step(const std::vector<Mask>& active, std::vector<Mask>& next, char symbol) const;
+};
+
+#endif // BITPARALLELMATCHER_H
@@ -0,0 +1,44 @@
+#ifndef DFAMINIMIZER_H
+#define DFAMINIMIZER_H
+
+#include <memory>
+#include <vector>
+#include <algo/RefinablePartition.h>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/SymbolClasses.h>
+
+/**
+ * Hopcroft's DFA minimization in O(n * k * log n).
+ *
+ * The partial input DFA is completed with an implicit dead state, blocks are refined by predecessor sets
+ * taken from per-symbol inverse transitions and only the smaller half of every split goes back to the worklist.
+ * States of the result record all substates of the merged states in State::substates,
+ * the block of the dead state is dropped again.
+ * Refinement runs over symbol classes, equivalent symbols would only repeat the same splits.
+ */
+class DFAMinimizer
+{
+public:
+    explicit DFAMinimizer(const Automaton& dfa);
+
+    std::unique_ptr<Automaton> minimize();
+
+private:
+    using StateId = FrozenTransitions::StateId;
+
+    const Automaton& dfa;
+    const FrozenTransitions& frozen;
+    std::size_t deadState;
+    SymbolClasses classes;
+    std::size_t symbolCount;  // classes with transitions, class c has index c - 1
+
+    // Predecessors of every state on every class in CSR layout, row of (class, state) is (class - 1) * (n + 1) + state
+    std::vector<std::size_t> inverseOffsets;
+    std::vector<std::size_t> inverseSources;
+
+    void buildInverse();
+    [[nodiscard]] std::unique_ptr<Automaton> buildQuotient(const RefinablePartition& partition) const;
+};
+
+#endif // DFAMINIMIZER_H
@@ -0,0 +1,63 @@
+#ifndef DETERMINIZER_H
+#define DETERMINIZER_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/State.h>
+#include <entity/SymbolClasses.h>
+
+/**
+ * Subset (powerset) construction for epsilon-free automata.
+ *
+ * Subsets of NFA states are packed into bitsets over the dense ids of the frozen transition layout
+ * and looked up in a hash table, so finding an already built DFA state does not depend on their number.
+ * Every DFA state records the union of substates of its NFA subset in State::substates.
+ * Successor subsets are computed once per symbol class and the DFA is kept as a table with one column per class;
+ * the char-keyed transitions of the resulting Automaton are expanded from it only once the construction is done.
+ */
+class Determinizer
+{
+public:
+    explicit Determinizer(const Automaton& nfa);
+
+    // Builds the DFA, transitions to the empty subset are left out (the result is partial)
+    std::unique_ptr<Automaton> determinize();
+
+    // The class-keyed DFA of the last determinize(), states are numbered like the states of the result
+    [[nodiscard]] const SymbolClasses& getSymbolClasses() const;
+    // Successor of the DFA state on the class, none for the empty subset (and for class 0)
+    [[nodiscard]] std::size_t successor(std::size_t state, SymbolClasses::ClassId symbolClass) const;
+
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+private:
+    using StateId = FrozenTransitions::StateId;
+    using Subset = std::vector<std::uint64_t>;
+
+    struct SubsetHash {
+        std::size_t operator()(const Subset& subset) const;
+    };
+
+    const Automaton& nfa;
+    const FrozenTransitions& frozen;
+    SymbolClasses classes;
+    std::size_t words;
+    std::vector<bool> finalStates;
+
+    std::unordered_map<Subset, std::size_t, SubsetHash> subsetIds;
+    std::vector<Subset> subsets;
+    std::vector<std::shared_ptr<State>> dfaStates;
+    std::vector<std::size_t> table;  // row of a DFA state has one entry per class, none for the empty subset
+
+    [[nodiscard]] Subset emptySubset() const;
+    std::size_t findOrAddSubset(Subset subset);
+    [[nodiscard]] std::shared_ptr<State> createState(const Subset& subset) const;
+    // Expands every class of the table to its member symbols
+    [[nodiscard]] TransitionsRelation::TransitionMap expandTable() const;
+};
+
+#endif // DETERMINIZER_H
@@ -0,0 +1,45 @@
+#ifndef EPSILONREMOVER_H
+#define EPSILONREMOVER_H
+
+#include <memory>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/FrozenTransitions.h>
+#include <entity/State.h>
+
+/**
+ * Removes epsilon ('\0') transitions from an automaton.
+ *
+ * Epsilon and symbol edges are indexed per state once (CSR layout), epsilon-SCCs are collapsed with Tarjan's algorithm
+ * and every SCC gets a single epsilon closure, shared by all of its states and reused both for building
+ * the new transitions and for deciding which states become final.
+ */
+class EpsilonRemover
+{
+public:
+    explicit EpsilonRemover(const Automaton& automaton);
+
+    // Replaces transitions, states and final states of the given automaton by the epsilon-free ones
+    void apply(Automaton& automaton) const;
+
+private:
+    using StateId = FrozenTransitions::StateId;
+
+    FrozenTransitions frozen;
+    int initialState;
+    std::vector<bool> finalStates;
+
+    std::vector<int> component;                 // epsilon-SCC of every state
+    std::vector<std::vector<int>> closures;     // epsilon closure of every SCC
+    std::vector<bool> closureHasFinal;          // whether the closure of an SCC contains a final state
+
+    [[nodiscard]] FrozenTransitions::EdgeRange epsilonEdges(StateId state) const;
+    [[nodiscard]] FrozenTransitions::EdgeRange symbolEdges(StateId state) const;
+
+    void collapseComponents();
+    void closeComponent(int componentId, const std::vector<int>& members);
+
+    [[nodiscard]] std::vector<FrozenTransitions::Edge> directTransitions(StateId state) const;
+};
+
+#endif // EPSILONREMOVER_H
@@ -0,0 +1,35 @@
+#ifndef GLUSHKOVBUILDER_H
+#define GLUSHKOVBUILDER_H
+
+#include <memory>
+#include <vector>
+#include <entity/Automaton.h>
+#include <entity/RegexNode.h>
+
+/**
+ * Glushkov (position automaton) construction.
+ *
+ * Every symbol occurrence of the expression is a position, first/last/follow sets are computed
+ * in one pass over the syntax tree and give an epsilon-free NFA with exactly n + 1 states:
+ * state 0 is initial and state i is entered by reading the i-th symbol occurrence.
+ */
+class GlushkovBuilder
+{
+public:
+    std::unique_ptr<Automaton> build(const RegexNode& root);
+
+private:
+    struct Sets {
+        bool nullable = false;
+        std::vector<int> first;
+        std::vector<int> last;
+    };
+
+    std::vector<char> symbols;              // symbol of every position, index 0 is the initial state
+    std::vector<std::vector<int>> follow;   // positions that may follow every position
+
+    Sets visit(const RegexNode& node);
+    void connect(const std::vector<int>& from, const std::vector<int>& to);
+};
+
+#endif // GLUSHKOVBUILDER_H
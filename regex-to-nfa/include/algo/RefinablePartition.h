@@ -0,0 +1,41 @@
+#ifndef REFINABLEPARTITION_H
+#define REFINABLEPARTITION_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Partition of the elements 0..n-1 into blocks that can only be refined.
+ *
+ * Elements of a block are stored contiguously, marked elements are moved to the front of their block,
+ * so marking is O(1) and splitting off the marked part costs only the number of marked elements.
+ */
+class RefinablePartition
+{
+public:
+    // All elements start in block 0
+    explicit RefinablePartition(std::size_t size);
+
+    [[nodiscard]] std::size_t blockCount() const;
+    [[nodiscard]] std::size_t blockOf(std::size_t element) const;
+    [[nodiscard]] std::size_t blockSize(std::size_t block) const;
+    [[nodiscard]] const std::size_t* begin(std::size_t block) const;
+    [[nodiscard]] const std::size_t* end(std::size_t block) const;
+
+    void mark(std::size_t element);
+    // Moves marked elements of every touched block into a new block, returns (old block, new block) pairs.
+    // Blocks whose elements are all marked stay as they are.
+    std::vector<std::pair<std::size_t, std::size_t>> splitMarked();
+
+private:
+    std::vector<std::size_t> elements;
+    std::vector<std::size_t> location;  // position of every element inside elements
+    std::vector<std::size_t> block;     // block of every element
+    std::vector<std::size_t> first;     // first position of every block
+    std::vector<std::size_t> past;      // position after the last element of every block
+    std::vector<std::size_t> marked;    // position after the last marked element of every block
+    std::vector<std::size_t> touched;
+};
+
+#endif // REFINABLEPARTITION_H
@@ -0,0 +1,33 @@
+#ifndef REGEXPARSER_H
+#define REGEXPARSER_H
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <entity/RegexNode.h>
+
+/**
+ * Recursive descent parser shared by all NFA constructions
+ */
+class RegexParser
+{
+private:
+    const std::string& regex;
+    // Index of the next unread character, the parser never copies the rest of the pattern
+    std::size_t position;
+
+    [[nodiscard]] bool atEnd() const;
+    [[nodiscard]] char peek() const;
+    [[nodiscard]] std::runtime_error parseError(const std::string& message) const;
+
+    std::unique_ptr<RegexNode> parseExpression();
+    std::unique_ptr<RegexNode> parseTerm();
+    std::unique_ptr<RegexNode> parseFactor();
+
+public:
+    explicit RegexParser(const std::string& regex);
+
+    std::unique_ptr<RegexNode> parse();
+};
+
+#endif // REGEXPARSER_H
@@ -3,45 +3,53 @@
 
 #include <string>
 #include <memory>
-#include <set>
 #include <vector>
 #include <entity/Automaton.h>
+#include <entity/RegexNode.h>
 #include <entity/State.h>
+#include <entity/StatePool.h>
 #include <entity/TransitionsRelation.h>
 
 class RegexToNFA
 {
+public:
+    // Thompson gives an NFA with epsilon transitions, Glushkov an epsilon-free one with a state per symbol occurrence
+    enum class Engine { Thompson, Glushkov };
+
 private:
+    // Sub-automaton under construction, Thompson fragments always have a single final state
+    struct Fragment {
+        std::size_t initialState;
+        std::size_t finalState;
+    };
+
+    struct Edge {
+        std::size_t from;
+        char symbol;
+        std::size_t to;
+    };
+
     std::string regex;
-    int stateCounter;
-
-    std::unique_ptr<Automaton> parseExpression();
-    std::unique_ptr<Automaton> parseTerm();
-    std::unique_ptr<Automaton> parseFactor();
-
-    std::shared_ptr<State> createState(bool isFinal = false);
-    static void addTransition(TransitionsRelation::TransitionMap& transitions,
-                              const std::shared_ptr<State>& from, char symbol, const std::shared_ptr<State>& to);
-
-    std::unique_ptr<Automaton> handleElementaryLanguage(char c);
-    std::unique_ptr<Automaton> handleEmptyWord();
-    std::unique_ptr<Automaton> handleDisjunction(std::unique_ptr<Automaton> left, std::unique_ptr<Automaton> right);
-    std::unique_ptr<Automaton> handleConcatenation(std::unique_ptr<Automaton> left, std::unique_ptr<Automaton> right);
-    std::unique_ptr<Automaton> handleKleeneStar(std::unique_ptr<Automaton> automata);
-
-    static std::set<std::shared_ptr<State>> findEpsilonClosure(
-        const std::shared_ptr<State>& state,
-        const TransitionsRelation::TransitionMap& transitions);
-    static void buildNewTransitions(
-        const TransitionsRelation::TransitionMap& oldTransitions,
-        TransitionsRelation::TransitionMap& newTransitions,
-        const std::vector<std::shared_ptr<State>>& states);
-    static std::set<std::shared_ptr<State>> findReachableStates(
-        const std::shared_ptr<State>& initialState,
-        const TransitionsRelation::TransitionMap& transitions);
+    Engine engine;
+
+    // States and edges are addressed by index until the whole automaton is built
+    StatePool pool;
+    std::vector<Edge> edges;
+
+    std::size_t createState(bool isFinal = false);
+    void addTransition(std::size_t from, char symbol, std::size_t to);
+
+    Fragment buildThompson(const RegexNode& node);
+    Fragment handleElementaryLanguage(char c);
+    Fragment handleEmptyWord();
+    Fragment handleDisjunction(Fragment left, Fragment right);
+    Fragment handleConcatenation(Fragment left, Fragment right);
+    Fragment handleKleeneStar(Fragment fragment);
+
+    std::unique_ptr<Automaton> materialize(Fragment fragment);
 
 public:
-    explicit RegexToNFA(const std::string& regex);
+    explicit RegexToNFA(const std::string& regex, Engine engine = Engine::Thompson);
 
     // Remove epsilon transitions and compute direct character transitions
     static void removeEpsilonTransitions(std::unique_ptr<Automaton>& automata);
@@ -35,6 +35,8 @@ public:
     [[nodiscard]] const State* getInitialState() const;
     [[nodiscard]] std::shared_ptr<State> getInitialStateShared() const;
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getStates() const;
+    // Mutable access (drops the CSR layout, freeze() also rebuilds it if the states change through a kept reference)
+    std::vector<std::shared_ptr<State>>& _getStates();
     [[nodiscard]] const std::vector<std::shared_ptr<State>>& getFinalStates() const;
     [[nodiscard]] const TransitionsRelation* getTransitionsRelation() const;
     TransitionsRelation* _getTransitionsRelation() const;
@@ -46,6 +48,9 @@ public:
     void setFinalStates(const std::vector<std::shared_ptr<State>>& newFinalStates);
     void setTransitionsRelation(std::unique_ptr<TransitionsRelation> newTransitionsRelation);
 
+    // Builds the CSR layout of the transitions (cached until transitions or states change)
+    const FrozenTransitions& freeze() const;
+
     [[nodiscard]] std::shared_ptr<State> findStateBySubstates(const std::set<int>& substates) const;
     [[nodiscard]] bool isDeterministic() const;
 
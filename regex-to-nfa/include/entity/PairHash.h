@@ -0,0 +1,18 @@
+#ifndef PAIRHASH_H
+#define PAIRHASH_H
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+struct PairHash {
+    template <class T1, class T2>
+    size_t operator()(const std::pair<std::shared_ptr<T1>, T2>& p) const
+    {
+        auto hash1 = std::hash<std::shared_ptr<T1>>{}(p.first);
+        auto hash2 = std::hash<T2>{}(p.second);
+        return hash1 ^ (hash2 << 1); // Combine the two hash values
+    }
+};
+
+#endif // PAIRHASH_H
@@ -0,0 +1,24 @@
+#ifndef REGEXNODE_H
+#define REGEXNODE_H
+
+#include <memory>
+#include <vector>
+
+/**
+ * Node of a parsed regular expression.
+ *
+ * Concatenation and disjunction are n-ary (children in the order they were written),
+ * every '*' wraps its operand into its own KleeneStar node.
+ */
+struct RegexNode
+{
+    enum class Type { Symbol, EmptyWord, Concatenation, Disjunction, KleeneStar };
+
+    Type type;
+    char symbol;
+    std::vector<std::unique_ptr<RegexNode>> children;
+
+    explicit RegexNode(Type type, char symbol = '\0') : type(type), symbol(symbol) {}
+};
+
+#endif // REGEXNODE_H
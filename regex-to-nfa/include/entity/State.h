@@ -4,23 +4,33 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <entity/SubstateSet.h>
 
 class State {
 private:
-    std::set<int> substates;
+    SubstateSet substates;
     bool final;
+    std::size_t substateHash;        // structural hash of the substates, kept in sync by every setter
+    std::string name;                // display name, rebuilt by every setter that changes it
 
-    [[nodiscard]] static std::string implode(const std::vector<int>& elements, char delimiter);
+    [[nodiscard]] static std::string implode(const SubstateSet& elements, char delimiter);
+    [[nodiscard]] static std::size_t hashSubstates(const SubstateSet& elements);
 
 public:
-    explicit State(std::set<int> substates, bool final = false);
+    explicit State(const std::set<int>& substates, bool final = false);
+    explicit State(SubstateSet substates, bool final = false);
+    explicit State(int substate, bool final = false);
 
     [[nodiscard]] bool isFinal() const;
     void setFinal(bool final = true);
-    [[nodiscard]] std::string getName() const;
+    [[nodiscard]] const std::string& getName() const;
+    // Hash of the substates only, std::hash<State> adds the final flag
+    [[nodiscard]] std::size_t getHash() const;
 
     bool isAtomic() const;
     const std::set<int> getSubstates() const;
+    // Same substates without building a std::set
+    [[nodiscard]] const SubstateSet& getSubstateSet() const;
     void setSubstates(const std::set<int>& newSubstates);
 
     bool operator==(const State& other) const;
@@ -0,0 +1,31 @@
+#ifndef STATEPOOL_H
+#define STATEPOOL_H
+
+#include <memory>
+#include <vector>
+#include <entity/State.h>
+
+/**
+ * Arena that owns the states of one construction.
+ *
+ * While an automaton is being built its states are addressed by index, no shared_ptr is created or copied.
+ * share() hands all of them over at once: the returned pointers alias a single allocation,
+ * so they share one control block instead of one per state.
+ */
+class StatePool
+{
+public:
+    // Creates a state with a single substate and returns its index
+    std::size_t create(int substate, bool final = false);
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] const State& operator[](std::size_t index) const;
+
+    // Moves the states into shared ownership, the pool is empty afterwards
+    std::vector<std::shared_ptr<State>> share();
+
+private:
+    std::vector<State> states;
+};
+
+#endif // STATEPOOL_H
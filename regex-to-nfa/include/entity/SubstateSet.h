@@ -0,0 +1,42 @@
+#ifndef SUBSTATESET_H
+#define SUBSTATESET_H
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+/**
+ * Sorted set of substate ids with inline storage for small sets.
+ *
+ * Almost every state has one or two substates, those are kept inside the object itself,
+ * only larger sets (e.g. subsets built by determinization) go to the heap.
+ */
+class SubstateSet
+{
+public:
+    SubstateSet() = default;
+    explicit SubstateSet(int substate);
+    explicit SubstateSet(const std::set<int>& substates);
+    // Elements are sorted and duplicates removed
+    explicit SubstateSet(std::vector<int> substates);
+
+    [[nodiscard]] const int* begin() const;
+    [[nodiscard]] const int* end() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] std::set<int> toSet() const;
+
+    bool operator==(const SubstateSet& other) const;
+    bool operator!=(const SubstateSet& other) const;
+    bool operator==(const std::set<int>& other) const;
+
+private:
+    static constexpr std::uint32_t inlineCapacity = 2;
+
+    std::uint32_t count = 0;
+    int inlineItems[inlineCapacity] = {};
+    std::vector<int> overflow;  // holds all elements once there are more than inlineCapacity
+};
+
+#endif // SUBSTATESET_H
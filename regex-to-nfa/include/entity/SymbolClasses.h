@@ -0,0 +1,48 @@
+#ifndef SYMBOLCLASSES_H
+#define SYMBOLCLASSES_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <entity/FrozenTransitions.h>
+
+/**
+ * Byte equivalence classes of a frozen transition relation.
+ *
+ * Two symbols are equivalent when every state moves to the same targets on both of them, so the automaton
+ * cannot tell them apart and any algorithm may work with one class id instead of each symbol.
+ * Class 0 holds every byte without transitions (and epsilon), real classes are numbered from 1
+ * in the order of their smallest symbol. Edges are stored once per class in the same CSR layout as FrozenTransitions.
+ */
+class SymbolClasses
+{
+public:
+    using ClassId = std::uint8_t;
+    using StateId = FrozenTransitions::StateId;
+
+    struct Edge
+    {
+        ClassId symbolClass;
+        StateId target;
+    };
+
+    explicit SymbolClasses(const FrozenTransitions& frozen);
+
+    // Number of classes including class 0
+    [[nodiscard]] std::size_t classCount() const;
+    [[nodiscard]] ClassId classOf(char symbol) const;
+    [[nodiscard]] const std::array<ClassId, 256>& getTable() const;
+    // Symbols of the class in ascending byte order
+    [[nodiscard]] const std::vector<char>& getMembers(ClassId symbolClass) const;
+
+    [[nodiscard]] const Edge* begin(StateId state) const;
+    [[nodiscard]] const Edge* end(StateId state) const;
+
+private:
+    std::array<ClassId, 256> table{};
+    std::vector<std::vector<char>> members;
+    std::vector<std::uint32_t> offsets;
+    std::vector<Edge> transitions;
+};
+
+#endif // SYMBOLCLASSES_H
@@ -1,32 +1,42 @@
 #ifndef TRANSITION_H
 #define TRANSITION_H
 
+#include <entity/FrozenTransitions.h>
+#include <entity/PairHash.h>
 #include <entity/State.h>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <utility>
 
-struct PairHash {
-    template <class T1, class T2>
-    size_t operator()(const std::pair<std::shared_ptr<T1>, T2>& p) const;
-};
-
 class TransitionsRelation {
 public:
     using TransitionKey = std::pair<std::shared_ptr<State>, char>;
     using TransitionMap = std::unordered_map<TransitionKey, std::vector<std::shared_ptr<State>>, PairHash>;
 
     explicit TransitionsRelation(TransitionMap transitions);
+    TransitionsRelation(const TransitionsRelation& other);
     std::vector<std::shared_ptr<State>> move(const std::shared_ptr<State>& current, char input) const;
+    // Works on the frozen layout, freeze() must have been called before
+    FrozenTransitions::EdgeRange move(FrozenTransitions::StateId current, char input) const;
 
     [[nodiscard]] const TransitionMap& getTransitions() const;
+    // Mutable access (drops the CSR layout), lets constructions splice the map instead of copying it
+    TransitionMap& _getTransitions();
 
     void addTransition(const std::shared_ptr<State>& startState, char input, const std::shared_ptr<State>& endState);
     void setTransitions(const TransitionMap& pairs);
 
+    // Builds (or returns the already built) CSR layout, state ids follow the order of the given states.
+    // A layout built for other states is rebuilt
+    const FrozenTransitions& freeze(const std::vector<std::shared_ptr<State>>& states) const;
+    [[nodiscard]] const FrozenTransitions* getFrozen() const;
+    // Drops the CSR layout, it is rebuilt on the next freeze()
+    void unfreeze();
+
 private:
     TransitionMap transitions;
+    mutable std::unique_ptr<const FrozenTransitions> frozen;
 };
 
 #endif // TRANSITION_H
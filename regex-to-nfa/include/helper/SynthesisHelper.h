@@ -6,13 +6,30 @@
 #define SYNTHESISHELPER_H
 #include <memory>
 #include <string>
+#include <vector>
+#include <algo/RegexToNFA.h>
 #include <entity/Automaton.h>
 
 class SynthesisHelper
 {
 public:
-    static std::unique_ptr<Automaton> getNFA(const std::string& regex, bool print = false);
+    static std::unique_ptr<Automaton> getNFA(const std::string& regex, bool print = false,
+                                             RegexToNFA::Engine engine = RegexToNFA::Engine::Thompson);
+    static std::unique_ptr<Automaton> getDFA(const std::string& regex, bool print = false);
+    static std::unique_ptr<Automaton> getMinimalDFA(const std::string& regex, bool print = false);
     static void examples();
+    // State counts of the NFA, the DFA and the minimal DFA of every example, compared on all short words
+    static void determinizationExamples();
+    // Thompson and Glushkov automata of the same regexes, compared on all short words
+    static void engineExamples();
+    // Bit-parallel matching checked against the NFA on all short words
+    static void matcherExamples();
+
+private:
+    static std::vector<std::string> exampleRegexes();
+    // Subset simulation of the automaton, the reference the other constructions are checked against
+    static bool accepts(const Automaton& automaton, const std::string& word);
+    static std::vector<std::string> wordsUpTo(const std::vector<char>& letters, std::size_t length);
 };
 
 #endif //SYNTHESISHELPER_H
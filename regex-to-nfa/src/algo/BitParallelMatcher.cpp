@@ -0,0 +1,153 @@
+#include <algo/BitParallelMatcher.h>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+BitParallelMatcher::BitParallelMatcher(const Automaton& nfa)
+    : positions(0), words(1), chunked(false), initialFinal(false) {
+    const FrozenTransitions& frozen = nfa.freeze();
+
+    // Every (state, incoming symbol) pair becomes one position
+    std::unordered_map<std::uint64_t, std::size_t> positionIds;
+    std::vector<std::vector<std::size_t>> statePositions(frozen.stateCount());
+    auto positionOf = [&](FrozenTransitions::StateId state, char symbol) {
+        const std::uint64_t key = std::uint64_t{state} << 8 | static_cast<unsigned char>(symbol);
+        auto [it, inserted] = positionIds.emplace(key, positions);
+        if (inserted) {
+            statePositions[state].push_back(positions++);
+        }
+        return it->second;
+    };
+
+    for (FrozenTransitions::StateId state = 0; state < frozen.stateCount(); ++state) {
+        for (const auto& edge : frozen.edges(state)) {
+            if (edge.symbol == '\0') {
+                throw std::runtime_error("Bit-parallel matching needs an automaton without epsilon transitions");
+            }
+            positionOf(edge.target, edge.symbol);
+        }
+    }
+
+    words = std::max<std::size_t>(1, (positions + 63) / 64);
+    initialFollow.assign(words, 0);
+    follow.assign(positions * words, 0);
+    symbolMasks.assign(256 * words, 0);
+    finalMask.assign(words, 0);
+
+    std::vector<bool> finalStates(frozen.stateCount(), false);
+    for (const auto& state : nfa.getFinalStates()) {
+        if (frozen.hasState(state.get())) {
+            finalStates[frozen.getId(state.get())] = true;
+        }
+    }
+
+    for (const auto& [key, position] : positionIds) {
+        const auto state = static_cast<FrozenTransitions::StateId>(key >> 8);
+        const auto symbol = static_cast<std::size_t>(key & 0xff);
+        symbolMasks[symbol * words + position / 64] |= Mask{1} << (position % 64);
+        if (finalStates[state]) {
+            finalMask[position / 64] |= Mask{1} << (position % 64);
+        }
+
+        Mask* positionFollow = &follow[position * words];
+        for (const auto& edge : frozen.edges(state)) {
+            const std::size_t target = positionIds.at(std::uint64_t{edge.target} << 8 | static_cast<unsigned char>(edge.symbol));
+            positionFollow[target / 64] |= Mask{1} << (target % 64);
+        }
+    }
+
+    if (nfa.getInitialStateShared()) {
+        const FrozenTransitions::StateId initial = frozen.getId(nfa.getInitialState());
+        initialFinal = finalStates[initial];
+        for (const auto& edge : frozen.edges(initial)) {
+            const std::size_t target = positionIds.at(std::uint64_t{edge.target} << 8 | static_cast<unsigned char>(edge.symbol));
+            initialFollow[target / 64] |= Mask{1} << (target % 64);
+        }
+    }
+
+    if (positions <= maxChunkedPositions) {
+        buildChunkTables();
+    }
+}
+
+// Follow of every value of every byte-sized chunk, built from the value without its lowest bit
+void BitParallelMatcher::buildChunkTables() {
+    chunked = true;
+    const std::size_t chunks = (positions + 7) / 8;
+    chunkFollow.assign(chunks * 256 * words, 0);
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        Mask* table = &chunkFollow[chunk * 256 * words];
+        for (std::size_t value = 1; value < 256; ++value) {
+            const std::size_t position = chunk * 8 + __builtin_ctz(static_cast<unsigned>(value));
+            if (position >= positions) continue;
+
+            const Mask* rest = table + (value & (value - 1)) * words;
+            const Mask* positionFollow = &follow[position * words];
+            for (std::size_t word = 0; word < words; ++word) {
+                table[value * words + word] = rest[word] | positionFollow[word];
+            }
+        }
+    }
+}
+
+void BitParallelMatcher::step(const std::vector<Mask>& active, std::vector<Mask>& next, char symbol) const {
+    std::fill(next.begin(), next.end(), 0);
+
+    if (chunked) {
+        for (std::size_t word = 0; word < words; ++word) {
+            for (Mask bits = active[word], chunk = word * 8; bits != 0; bits >>= 8, ++chunk) {
+                const std::size_t value = bits & 0xff;
+                if (value == 0) continue;
+                const Mask* row = &chunkFollow[(chunk * 256 + value) * words];
+                for (std::size_t i = 0; i < words; ++i) {
+                    next[i] |= row[i];
+                }
+            }
+        }
+    } else {
+        for (std::size_t word = 0; word < words; ++word) {
+            for (Mask bits = active[word]; bits != 0; bits &= bits - 1) {
+                const Mask* row = &follow[(word * 64 + __builtin_ctzll(bits)) * words];
+                for (std::size_t i = 0; i < words; ++i) {
+                    next[i] |= row[i];
+                }
+            }
+        }
+    }
+
+    const Mask* mask = &symbolMasks[static_cast<unsigned char>(symbol) * words];
+    for (std::size_t i = 0; i < words; ++i) {
+        next[i] &= mask[i];
+    }
+}
+
+bool BitParallelMatcher::matches(const std::string& word) const {
+    if (word.empty()) {
+        return initialFinal;
+    }
+
+    std::vector<Mask> active(words);
+    std::vector<Mask> next(words);
+    const Mask* mask = &symbolMasks[static_cast<unsigned char>(word[0]) * words];
+    bool alive = false;
+    for (std::size_t i = 0; i < words; ++i) {
+        active[i] = initialFollow[i] & mask[i];
+        alive = alive || active[i] != 0;
+    }
+
+    for (std::size_t i = 1; i < word.size() && alive; ++i) {
+        step(active, next, word[i]);
+        active.swap(next);
+        alive = std::any_of(active.begin(), active.end(), [](Mask bits) { return bits != 0; });
+    }
+
+    for (std::size_t i = 0; i < words; ++i) {
+        if (active[i] & finalMask[i]) return true;
+    }
+    return false;
+}
+
+std::size_t BitParallelMatcher::positionCount() const {
+    return positions;
+}
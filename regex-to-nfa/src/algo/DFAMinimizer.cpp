@@ -0,0 +1,160 @@
+#include <algo/DFAMinimizer.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+DFAMinimizer::DFAMinimizer(const Automaton& dfa)
+    : dfa(dfa), frozen(dfa.freeze()), deadState(frozen.stateCount()), classes(frozen),
+      symbolCount(classes.classCount() - 1) {
+    if (!dfa.isDeterministic()) {
+        throw std::runtime_error("Only deterministic automata can be minimized");
+    }
+
+    for (StateId state = 0; state < frozen.stateCount(); ++state) {
+        for (const auto& edge : frozen.edges(state)) {
+            if (edge.symbol == '\0') {
+                throw std::runtime_error("Only deterministic automata can be minimized");
+            }
+        }
+    }
+
+    buildInverse();
+}
+
+// Missing transitions go to the dead state, which loops on every symbol
+void DFAMinimizer::buildInverse() {
+    const std::size_t size = deadState + 1;
+    std::vector<StateId> successors(symbolCount * size, static_cast<StateId>(deadState));
+    for (StateId state = 0; state < frozen.stateCount(); ++state) {
+        for (const auto* edge = classes.begin(state); edge != classes.end(state); ++edge) {
+            successors[(edge->symbolClass - 1) * size + state] = edge->target;
+        }
+    }
+
+    inverseOffsets.assign(successors.size() + 1, 0);
+    for (std::size_t symbol = 0; symbol < symbolCount; ++symbol) {
+        for (std::size_t state = 0; state < size; ++state) {
+            ++inverseOffsets[symbol * size + successors[symbol * size + state] + 1];
+        }
+    }
+    for (std::size_t row = 0; row < successors.size(); ++row) {
+        inverseOffsets[row + 1] += inverseOffsets[row];
+    }
+
+    inverseSources.resize(successors.size());
+    std::vector<std::size_t> cursor(inverseOffsets.begin(), inverseOffsets.end() - 1);
+    for (std::size_t symbol = 0; symbol < symbolCount; ++symbol) {
+        for (std::size_t state = 0; state < size; ++state) {
+            inverseSources[cursor[symbol * size + successors[symbol * size + state]]++] = state;
+        }
+    }
+}
+
+std::unique_ptr<Automaton> DFAMinimizer::minimize() {
+    const std::size_t size = deadState + 1;
+    RefinablePartition partition(size);
+
+    for (const auto& state : dfa.getFinalStates()) {
+        if (frozen.hasState(state.get())) {
+            partition.mark(frozen.getId(state.get()));
+        }
+    }
+    partition.splitMarked();
+
+    // (block, symbol) splitters; with a single block there is nothing to refine
+    std::vector<std::pair<std::size_t, std::size_t>> worklist;
+    std::vector<std::vector<bool>> inWorklist(partition.blockCount(), std::vector<bool>(symbolCount, false));
+    if (partition.blockCount() == 2) {
+        const std::size_t smaller = partition.blockSize(0) <= partition.blockSize(1) ? 0 : 1;
+        for (std::size_t symbol = 0; symbol < symbolCount; ++symbol) {
+            worklist.emplace_back(smaller, symbol);
+            inWorklist[smaller][symbol] = true;
+        }
+    }
+
+    std::vector<std::size_t> members;
+    while (!worklist.empty()) {
+        const auto [splitter, symbol] = worklist.back();
+        worklist.pop_back();
+        inWorklist[splitter][symbol] = false;
+
+        // marking may reorder the splitter itself, so its members are copied first
+        members.assign(partition.begin(splitter), partition.end(splitter));
+        for (std::size_t member : members) {
+            const std::size_t row = symbol * size + member;
+            for (std::size_t i = inverseOffsets[row]; i < inverseOffsets[row + 1]; ++i) {
+                partition.mark(inverseSources[i]);
+            }
+        }
+
+        for (const auto& [oldBlock, newBlock] : partition.splitMarked()) {
+            inWorklist.emplace_back(symbolCount, false);
+            const std::size_t smaller = partition.blockSize(newBlock) <= partition.blockSize(oldBlock) ? newBlock : oldBlock;
+            for (std::size_t s = 0; s < symbolCount; ++s) {
+                const std::size_t added = inWorklist[oldBlock][s] ? newBlock : smaller;
+                if (!inWorklist[added][s]) {
+                    inWorklist[added][s] = true;
+                    worklist.emplace_back(added, s);
+                }
+            }
+        }
+    }
+
+    return buildQuotient(partition);
+}
+
+std::unique_ptr<Automaton> DFAMinimizer::buildQuotient(const RefinablePartition& partition) const {
+    const std::size_t deadBlock = partition.blockOf(deadState);
+    std::vector<std::shared_ptr<State>> blockStates(partition.blockCount());
+    std::vector<std::shared_ptr<State>> states;
+    std::vector<std::shared_ptr<State>> finalStates;
+
+    std::vector<bool> isFinal(frozen.stateCount(), false);
+    for (const auto& state : dfa.getFinalStates()) {
+        if (frozen.hasState(state.get())) {
+            isFinal[frozen.getId(state.get())] = true;
+        }
+    }
+
+    // States keep the order of their first member in the input automaton
+    for (StateId state = 0; state < frozen.stateCount(); ++state) {
+        const std::size_t block = partition.blockOf(state);
+        if (block == deadBlock || blockStates[block]) continue;
+
+        std::vector<int> substates;
+        for (const std::size_t* it = partition.begin(block); it != partition.end(block); ++it) {
+            const auto& memberSubstates = frozen.getState(*it)->getSubstateSet();
+            substates.insert(substates.end(), memberSubstates.begin(), memberSubstates.end());
+        }
+        blockStates[block] = std::make_shared<State>(SubstateSet(std::move(substates)), isFinal[state]);
+        states.push_back(blockStates[block]);
+        if (isFinal[state]) {
+            finalStates.push_back(blockStates[block]);
+        }
+    }
+
+    TransitionsRelation::TransitionMap transitions;
+    for (StateId state = 0; state < frozen.stateCount(); ++state) {
+        const auto& from = blockStates[partition.blockOf(state)];
+        if (!from) continue;
+        for (const auto& edge : frozen.edges(state)) {
+            const auto& to = blockStates[partition.blockOf(edge.target)];
+            if (to) {
+                transitions[{from, edge.symbol}] = {to};
+            }
+        }
+    }
+
+    // An empty language leaves only the dead block, the initial state is kept as a lone non-final state
+    std::shared_ptr<State> initialState;
+    if (dfa.getInitialStateShared()) {
+        initialState = blockStates[partition.blockOf(frozen.getId(dfa.getInitialState()))];
+        if (!initialState) {
+            initialState = std::make_shared<State>(dfa.getInitialState()->getSubstateSet());
+            states.insert(states.begin(), initialState);
+        }
+    }
+
+    return std::make_unique<Automaton>(std::make_unique<Alphabet>(dfa.getAlphabet()->getLetters()), initialState,
+                                       states, finalStates, std::move(transitions));
+}
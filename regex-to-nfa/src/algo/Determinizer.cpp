@@ -0,0 +1,143 @@
+#include <algo/Determinizer.h>
+#include <algorithm>
+#include <stdexcept>
+
+std::size_t Determinizer::SubsetHash::operator()(const Subset& subset) const {
+    std::size_t hashValue = 0;
+    for (std::uint64_t word : subset) {
+        hashValue ^= std::hash<std::uint64_t>{}(word) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+    }
+    return hashValue;
+}
+
+Determinizer::Determinizer(const Automaton& nfa)
+    : nfa(nfa), frozen(nfa.freeze()), classes(frozen), words((frozen.stateCount() + 63) / 64) {
+    finalStates.assign(frozen.stateCount(), false);
+    for (const auto& state : nfa.getFinalStates()) {
+        if (frozen.hasState(state.get())) {
+            finalStates[frozen.getId(state.get())] = true;
+        }
+    }
+}
+
+Determinizer::Subset Determinizer::emptySubset() const {
+    return Subset(words, 0);
+}
+
+// Returns the id of the DFA state for the given subset, new subsets get the next id and wait in the worklist
+std::size_t Determinizer::findOrAddSubset(Subset subset) {
+    auto it = subsetIds.find(subset);
+    if (it != subsetIds.end()) {
+        return it->second;
+    }
+
+    const std::size_t id = subsets.size();
+    dfaStates.push_back(createState(subset));
+    table.resize(table.size() + classes.classCount(), none);
+    subsetIds.emplace(subset, id);
+    subsets.push_back(std::move(subset));
+    return id;
+}
+
+std::shared_ptr<State> Determinizer::createState(const Subset& subset) const {
+    std::vector<int> substates;
+    bool isFinal = false;
+    for (std::size_t word = 0; word < words; ++word) {
+        for (std::uint64_t bits = subset[word]; bits != 0; bits &= bits - 1) {
+            const auto id = static_cast<StateId>(word * 64 + __builtin_ctzll(bits));
+            const auto& memberSubstates = frozen.getState(id)->getSubstateSet();
+            substates.insert(substates.end(), memberSubstates.begin(), memberSubstates.end());
+            isFinal = isFinal || finalStates[id];
+        }
+    }
+    return std::make_shared<State>(SubstateSet(std::move(substates)), isFinal);
+}
+
+std::unique_ptr<Automaton> Determinizer::determinize() {
+    auto alphabet = std::make_unique<Alphabet>(nfa.getAlphabet()->getLetters());
+    if (!nfa.getInitialStateShared()) {
+        return std::make_unique<Automaton>(std::move(alphabet), nullptr, std::vector<std::shared_ptr<State>>{},
+                                           std::vector<std::shared_ptr<State>>{},
+                                           TransitionsRelation::TransitionMap());
+    }
+
+    for (StateId state = 0; state < frozen.stateCount(); ++state) {
+        const auto row = frozen.edges(state);
+        // epsilon edges open every row
+        if (!row.empty() && row.begin()->symbol == '\0') {
+            throw std::runtime_error("Determinizer expects an automaton without epsilon transitions");
+        }
+    }
+
+    subsetIds.clear();
+    subsets.clear();
+    dfaStates.clear();
+    table.clear();
+
+    Subset initial = emptySubset();
+    const StateId initialId = frozen.getId(nfa.getInitialState());
+    initial[initialId / 64] |= std::uint64_t{1} << (initialId % 64);
+    findOrAddSubset(std::move(initial));
+
+    std::vector<SymbolClasses::Edge> moves;
+
+    // Ids are given in discovery order, so the not yet processed ids form the worklist
+    for (std::size_t current = 0; current < subsets.size(); ++current) {
+        moves.clear();
+        for (std::size_t word = 0; word < words; ++word) {
+            for (std::uint64_t bits = subsets[current][word]; bits != 0; bits &= bits - 1) {
+                const auto state = static_cast<StateId>(word * 64 + __builtin_ctzll(bits));
+                moves.insert(moves.end(), classes.begin(state), classes.end(state));
+            }
+        }
+        std::sort(moves.begin(), moves.end(), [](const auto& left, const auto& right) {
+            return left.symbolClass < right.symbolClass;
+        });
+
+        for (std::size_t i = 0; i < moves.size();) {
+            const SymbolClasses::ClassId symbolClass = moves[i].symbolClass;
+            Subset next = emptySubset();
+            for (; i < moves.size() && moves[i].symbolClass == symbolClass; ++i) {
+                next[moves[i].target / 64] |= std::uint64_t{1} << (moves[i].target % 64);
+            }
+            const std::size_t target = findOrAddSubset(std::move(next));
+            table[current * classes.classCount() + symbolClass] = target;
+        }
+    }
+
+    std::vector<std::shared_ptr<State>> finalDfaStates;
+    for (const auto& state : dfaStates) {
+        if (state->isFinal()) {
+            finalDfaStates.push_back(state);
+        }
+    }
+
+    return std::make_unique<Automaton>(std::move(alphabet), dfaStates.front(), dfaStates, finalDfaStates,
+                                       expandTable());
+}
+
+// The Automaton keeps transitions per char, so this is the only place the classes are taken apart again
+TransitionsRelation::TransitionMap Determinizer::expandTable() const {
+    TransitionsRelation::TransitionMap transitions;
+    const std::size_t classCount = classes.classCount();
+    for (std::size_t state = 0; state < dfaStates.size(); ++state) {
+        for (std::size_t symbolClass = 1; symbolClass < classCount; ++symbolClass) {
+            const std::size_t target = table[state * classCount + symbolClass];
+            if (target == none) {
+                continue;
+            }
+            for (char symbol : classes.getMembers(static_cast<SymbolClasses::ClassId>(symbolClass))) {
+                transitions[{dfaStates[state], symbol}] = {dfaStates[target]};
+            }
+        }
+    }
+    return transitions;
+}
+
+const SymbolClasses& Determinizer::getSymbolClasses() const {
+    return classes;
+}
+
+std::size_t Determinizer::successor(std::size_t state, SymbolClasses::ClassId symbolClass) const {
+    return table.at(state * classes.classCount() + symbolClass);
+}
@@ -0,0 +1,184 @@
+#include <algo/EpsilonRemover.h>
+#include <algorithm>
+#include <queue>
+
+EpsilonRemover::EpsilonRemover(const Automaton& automaton)
+    : frozen(automaton.getStates(), automaton.getTransitionsRelation()->getTransitions()),
+      initialState(-1) {
+    if (automaton.getInitialStateShared() && frozen.hasState(automaton.getInitialState())) {
+        initialState = static_cast<int>(frozen.getId(automaton.getInitialState()));
+    }
+
+    finalStates.assign(frozen.stateCount(), false);
+    for (const auto& state : automaton.getFinalStates()) {
+        if (frozen.hasState(state.get())) {
+            finalStates[frozen.getId(state.get())] = true;
+        }
+    }
+
+    collapseComponents();
+}
+
+// Epsilon edges open every row of the frozen layout
+FrozenTransitions::EdgeRange EpsilonRemover::epsilonEdges(StateId state) const {
+    return frozen.move(state, '\0');
+}
+
+FrozenTransitions::EdgeRange EpsilonRemover::symbolEdges(StateId state) const {
+    return {epsilonEdges(state).end(), frozen.edges(state).end()};
+}
+
+// Iterative Tarjan's algorithm over epsilon edges. Components are completed in reverse topological order,
+// so the closures of all successor components already exist when a component is closed.
+void EpsilonRemover::collapseComponents() {
+    const int size = static_cast<int>(frozen.stateCount());
+    component.assign(size, -1);
+
+    std::vector<int> index(size, -1);
+    std::vector<int> lowLink(size, 0);
+    std::vector<bool> onStack(size, false);
+    std::vector<int> sccStack;
+    std::vector<std::pair<int, std::size_t>> callStack; // (state, next epsilon edge to visit)
+    int counter = 0;
+
+    auto discover = [&](int state) {
+        index[state] = lowLink[state] = counter++;
+        sccStack.push_back(state);
+        onStack[state] = true;
+        callStack.emplace_back(state, 0);
+    };
+
+    for (int root = 0; root < size; ++root) {
+        if (index[root] != -1) continue;
+        discover(root);
+
+        while (!callStack.empty()) {
+            const int state = callStack.back().first;
+            std::size_t& nextEdge = callStack.back().second;
+
+            const auto edges = epsilonEdges(state);
+            if (nextEdge < edges.size()) {
+                const int target = static_cast<int>(edges.begin()[nextEdge++].target);
+                if (index[target] == -1) {
+                    discover(target);
+                } else if (onStack[target]) {
+                    lowLink[state] = std::min(lowLink[state], index[target]);
+                }
+                continue;
+            }
+
+            if (lowLink[state] == index[state]) {
+                std::vector<int> members;
+                int member;
+                do {
+                    member = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[member] = false;
+                    members.push_back(member);
+                } while (member != state);
+                closeComponent(static_cast<int>(closures.size()), members);
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                const int parent = callStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[state]);
+            }
+        }
+    }
+}
+
+void EpsilonRemover::closeComponent(int componentId, const std::vector<int>& members) {
+    for (int member : members) {
+        component[member] = componentId;
+    }
+
+    std::vector<int> closure = members;
+    bool hasFinal = false;
+    std::vector<int> mergedComponents;
+
+    for (int member : members) {
+        hasFinal = hasFinal || finalStates[member];
+        for (const auto& edge : epsilonEdges(member)) {
+            const int successor = component[edge.target];
+            if (successor == componentId ||
+                std::find(mergedComponents.begin(), mergedComponents.end(), successor) != mergedComponents.end()) {
+                continue;
+            }
+            mergedComponents.push_back(successor);
+            closure.insert(closure.end(), closures[successor].begin(), closures[successor].end());
+            hasFinal = hasFinal || closureHasFinal[successor];
+        }
+    }
+
+    // closures of different successors may overlap
+    if (mergedComponents.size() > 1) {
+        std::sort(closure.begin(), closure.end());
+        closure.erase(std::unique(closure.begin(), closure.end()), closure.end());
+    }
+
+    closures.push_back(std::move(closure));
+    closureHasFinal.push_back(hasFinal);
+}
+
+// Symbol transitions of a state after skipping any number of epsilon moves, sorted and without duplicates
+std::vector<FrozenTransitions::Edge> EpsilonRemover::directTransitions(StateId state) const {
+    std::vector<FrozenTransitions::Edge> result;
+    for (int closureState : closures[component[state]]) {
+        const auto edges = symbolEdges(closureState);
+        result.insert(result.end(), edges.begin(), edges.end());
+    }
+    std::sort(result.begin(), result.end(), [](const auto& left, const auto& right) {
+        if (left.symbol != right.symbol) return FrozenTransitions::symbolLess(left.symbol, right.symbol);
+        return left.target < right.target;
+    });
+    result.erase(std::unique(result.begin(), result.end(), [](const auto& left, const auto& right) {
+        return left.symbol == right.symbol && left.target == right.target;
+    }), result.end());
+    return result;
+}
+
+void EpsilonRemover::apply(Automaton& automaton) const {
+    TransitionsRelation::TransitionMap newTransitions;
+    std::vector<bool> reachable(frozen.stateCount(), false);
+
+    // Only states reachable from the initial state get their transitions rebuilt
+    std::queue<StateId> queue;
+    if (initialState != -1) {
+        reachable[initialState] = true;
+        queue.push(static_cast<StateId>(initialState));
+    }
+
+    while (!queue.empty()) {
+        const StateId state = queue.front();
+        queue.pop();
+
+        const auto transitions = directTransitions(state);
+        for (std::size_t i = 0; i < transitions.size();) {
+            const char symbol = transitions[i].symbol;
+            auto& targets = newTransitions[{frozen.getState(state), symbol}];
+            for (; i < transitions.size() && transitions[i].symbol == symbol; ++i) {
+                const StateId target = transitions[i].target;
+                targets.push_back(frozen.getState(target));
+                if (!reachable[target]) {
+                    reachable[target] = true;
+                    queue.push(target);
+                }
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<State>> newStates;
+    std::vector<std::shared_ptr<State>> newFinalStates;
+    for (StateId i = 0; i < frozen.stateCount(); ++i) {
+        if (!reachable[i]) continue;
+        newStates.push_back(frozen.getState(i));
+        if (closureHasFinal[component[i]]) {
+            newFinalStates.push_back(frozen.getState(i));
+        }
+    }
+
+    automaton.setTransitionsRelation(std::make_unique<TransitionsRelation>(std::move(newTransitions)));
+    automaton.setStates(newStates);
+    automaton.setFinalStates(newFinalStates);
+}
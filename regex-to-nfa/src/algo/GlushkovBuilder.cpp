@@ -0,0 +1,100 @@
+#include <algo/GlushkovBuilder.h>
+#include <entity/StatePool.h>
+#include <algorithm>
+#include <utility>
+
+void GlushkovBuilder::connect(const std::vector<int>& from, const std::vector<int>& to) {
+    for (int position : from) {
+        follow[position].insert(follow[position].end(), to.begin(), to.end());
+    }
+}
+
+// Positions of different subexpressions never overlap, so first and last sets are merged by appending
+GlushkovBuilder::Sets GlushkovBuilder::visit(const RegexNode& node) {
+    Sets result;
+    switch (node.type) {
+    case RegexNode::Type::Symbol: {
+        const int position = static_cast<int>(symbols.size());
+        symbols.push_back(node.symbol);
+        follow.emplace_back();
+        result.first = result.last = {position};
+        break;
+    }
+    case RegexNode::Type::EmptyWord:
+        result.nullable = true;
+        break;
+    case RegexNode::Type::Disjunction:
+        for (const auto& child : node.children) {
+            Sets sets = visit(*child);
+            result.nullable = result.nullable || sets.nullable;
+            result.first.insert(result.first.end(), sets.first.begin(), sets.first.end());
+            result.last.insert(result.last.end(), sets.last.begin(), sets.last.end());
+        }
+        break;
+    case RegexNode::Type::Concatenation: {
+        result.nullable = true;
+        for (const auto& child : node.children) {
+            Sets sets = visit(*child);
+            connect(result.last, sets.first);
+            if (result.nullable) {
+                result.first.insert(result.first.end(), sets.first.begin(), sets.first.end());
+            }
+            if (sets.nullable) {
+                result.last.insert(result.last.end(), sets.last.begin(), sets.last.end());
+            } else {
+                result.last = std::move(sets.last);
+            }
+            result.nullable = result.nullable && sets.nullable;
+        }
+        break;
+    }
+    case RegexNode::Type::KleeneStar:
+        result = visit(*node.children.front());
+        connect(result.last, result.first);
+        result.nullable = true;
+        break;
+    }
+    return result;
+}
+
+std::unique_ptr<Automaton> GlushkovBuilder::build(const RegexNode& root) {
+    symbols.assign(1, '\0');
+    follow.assign(1, {});
+
+    Sets sets = visit(root);
+    follow[0] = sets.first;
+
+    StatePool pool;
+    for (std::size_t position = 0; position < symbols.size(); ++position) {
+        pool.create(static_cast<int>(position));
+    }
+    std::vector<std::shared_ptr<State>> states = pool.share();
+
+    std::vector<std::shared_ptr<State>> finalStates;
+    if (sets.nullable) {
+        sets.last.push_back(0);
+    }
+    std::sort(sets.last.begin(), sets.last.end());
+    for (int position : sets.last) {
+        states[position]->setFinal();
+        finalStates.push_back(states[position]);
+    }
+
+    // Nested stars may add the same follow pair more than once
+    TransitionsRelation::TransitionMap transitions;
+    std::vector<char> letters;
+    for (std::size_t position = 0; position < symbols.size(); ++position) {
+        auto& targets = follow[position];
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+        for (int target : targets) {
+            transitions[{states[position], symbols[target]}].push_back(states[target]);
+        }
+        if (position > 0 && std::find(letters.begin(), letters.end(), symbols[position]) == letters.end()) {
+            letters.push_back(symbols[position]);
+        }
+    }
+
+    return std::make_unique<Automaton>(std::make_unique<Alphabet>(letters), states.front(), states, finalStates,
+                                       std::move(transitions));
+}
@@ -0,0 +1,73 @@
+#include <algo/RefinablePartition.h>
+#include <utility>
+
+RefinablePartition::RefinablePartition(std::size_t size)
+    : elements(size), location(size), block(size, 0) {
+    for (std::size_t i = 0; i < size; ++i) {
+        elements[i] = location[i] = i;
+    }
+    if (size > 0) {
+        first.push_back(0);
+        past.push_back(size);
+        marked.push_back(0);
+    }
+}
+
+std::size_t RefinablePartition::blockCount() const {
+    return first.size();
+}
+
+std::size_t RefinablePartition::blockOf(std::size_t element) const {
+    return block[element];
+}
+
+std::size_t RefinablePartition::blockSize(std::size_t block) const {
+    return past[block] - first[block];
+}
+
+const std::size_t* RefinablePartition::begin(std::size_t block) const {
+    return elements.data() + first[block];
+}
+
+const std::size_t* RefinablePartition::end(std::size_t block) const {
+    return elements.data() + past[block];
+}
+
+void RefinablePartition::mark(std::size_t element) {
+    const std::size_t owner = block[element];
+    const std::size_t position = location[element];
+    if (position < marked[owner]) return; // already marked
+
+    if (marked[owner] == first[owner]) {
+        touched.push_back(owner);
+    }
+
+    // swap the element with the first unmarked one
+    const std::size_t target = marked[owner]++;
+    std::swap(elements[position], elements[target]);
+    location[elements[position]] = position;
+    location[elements[target]] = target;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> RefinablePartition::splitMarked() {
+    std::vector<std::pair<std::size_t, std::size_t>> splits;
+    for (std::size_t owner : touched) {
+        const std::size_t boundary = marked[owner];
+        marked[owner] = first[owner];
+        if (boundary == past[owner]) continue;
+
+        const std::size_t created = first.size();
+        first.push_back(first[owner]);
+        past.push_back(boundary);
+        marked.push_back(first[owner]);
+        for (std::size_t position = first[owner]; position < boundary; ++position) {
+            block[elements[position]] = created;
+        }
+
+        first[owner] = boundary;
+        marked[owner] = boundary;
+        splits.emplace_back(owner, created);
+    }
+    touched.clear();
+    return splits;
+}
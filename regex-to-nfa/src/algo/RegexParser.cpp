@@ -0,0 +1,88 @@
+#include <algo/RegexParser.h>
+
+RegexParser::RegexParser(const std::string& regex) : regex(regex), position(0) {}
+
+bool RegexParser::atEnd() const {
+    return position >= regex.size();
+}
+
+// Returns current character without consuming it, '\0' at the end of the input
+char RegexParser::peek() const {
+    return atEnd() ? '\0' : regex[position];
+}
+
+std::runtime_error RegexParser::parseError(const std::string& message) const {
+    return std::runtime_error(message + " at position " + std::to_string(position));
+}
+
+std::unique_ptr<RegexNode> RegexParser::parseExpression() {
+    auto result = parseTerm();
+    if (atEnd() || peek() != '|') {
+        return result;
+    }
+
+    auto disjunction = std::make_unique<RegexNode>(RegexNode::Type::Disjunction);
+    disjunction->children.push_back(std::move(result));
+    while (!atEnd() && peek() == '|') {
+        ++position;
+        disjunction->children.push_back(parseTerm());
+    }
+    return disjunction;
+}
+
+std::unique_ptr<RegexNode> RegexParser::parseTerm() {
+    auto result = parseFactor();
+    if (atEnd() || peek() == ')' || peek() == '|') {
+        return result;
+    }
+
+    auto concatenation = std::make_unique<RegexNode>(RegexNode::Type::Concatenation);
+    concatenation->children.push_back(std::move(result));
+    while (!atEnd() && peek() != ')' && peek() != '|') {
+        concatenation->children.push_back(parseFactor());
+    }
+    return concatenation;
+}
+
+std::unique_ptr<RegexNode> RegexParser::parseFactor() {
+    std::unique_ptr<RegexNode> result;
+    if (atEnd()) {
+        return std::make_unique<RegexNode>(RegexNode::Type::EmptyWord);
+    }
+
+    if (regex.compare(position, 3, "EPS") == 0) {
+        position += 3;
+        return std::make_unique<RegexNode>(RegexNode::Type::EmptyWord);
+    }
+
+    char c = regex[position++];
+
+    if (c == '(') {
+        result = parseExpression();
+        if (peek() == ')') {
+            ++position;
+        } else {
+            throw parseError("Mismatched parentheses");
+        }
+    } else {
+        result = std::make_unique<RegexNode>(RegexNode::Type::Symbol, c);
+    }
+
+    while (!atEnd() && peek() == '*') {
+        auto star = std::make_unique<RegexNode>(RegexNode::Type::KleeneStar);
+        star->children.push_back(std::move(result));
+        result = std::move(star);
+        ++position;
+    }
+
+    return result;
+}
+
+std::unique_ptr<RegexNode> RegexParser::parse() {
+    position = 0;
+    auto result = parseExpression();
+    if (!atEnd()) {
+        throw parseError(std::string("Unexpected '") + peek() + "'");
+    }
+    return result;
+}
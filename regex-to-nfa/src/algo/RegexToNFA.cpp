@@ -1,361 +1,129 @@
 #include <algo/RegexToNFA.h>
+#include <algo/EpsilonRemover.h>
+#include <algo/GlushkovBuilder.h>
+#include <algo/RegexParser.h>
 #include <stdexcept>
 #include <algorithm>
-#include <stack>
 
 // Constructor
-RegexToNFA::RegexToNFA(const std::string& regex) : regex(regex), stateCounter(0) {}
-
-std::unique_ptr<Automaton> RegexToNFA::parseExpression() {
-    auto result = parseTerm();
-    while (regex.length() > 0 && regex[0] == '|') {
-        regex = regex.substr(1);
-        auto right = parseTerm();
-        result = handleDisjunction(std::move(result), std::move(right));
-    }
-    return result;
-}
-
-std::unique_ptr<Automaton> RegexToNFA::parseTerm() {
-    auto result = parseFactor();
-    while (regex.length() > 0 && regex[0] != ')' && regex[0] != '|') {
-        auto right = parseFactor();
-        result = handleConcatenation(std::move(result), std::move(right));
-    }
-    return result;
-}
-
-std::unique_ptr<Automaton> RegexToNFA::parseFactor() {
-    std::unique_ptr<Automaton> result;
-    if (regex.empty()) {
+RegexToNFA::RegexToNFA(const std::string& regex, Engine engine) : regex(regex), engine(engine) {}
+
+// Operands are built left to right, so states are numbered in the order they appear in the pattern
+RegexToNFA::Fragment RegexToNFA::buildThompson(const RegexNode& node) {
+    switch (node.type) {
+    case RegexNode::Type::Symbol:
+        return handleElementaryLanguage(node.symbol);
+    case RegexNode::Type::EmptyWord:
         return handleEmptyWord();
+    case RegexNode::Type::KleeneStar:
+        return handleKleeneStar(buildThompson(*node.children.front()));
+    case RegexNode::Type::Concatenation:
+    case RegexNode::Type::Disjunction:
+        break;
     }
 
-    if (regex.substr(0, 3) == "EPS") {
-        regex = regex.substr(3);
-        return handleEmptyWord();
+    Fragment result = buildThompson(*node.children.front());
+    for (std::size_t i = 1; i < node.children.size(); ++i) {
+        Fragment right = buildThompson(*node.children[i]);
+        result = node.type == RegexNode::Type::Concatenation
+                     ? handleConcatenation(result, right)
+                     : handleDisjunction(result, right);
     }
-
-    char c = regex[0];
-    regex = regex.substr(1);
-
-    if (c == '(') {
-        result = parseExpression();
-        if (regex[0] == ')') {
-            regex = regex.substr(1);
-        } else {
-            throw std::runtime_error("Mismatched parentheses");
-        }
-    } else {
-        result = handleElementaryLanguage(c);
-    }
-
-    while (regex.length() > 0 && regex[0] == '*') {
-        result = handleKleeneStar(std::move(result));
-        regex = regex.substr(1);
-    }
-
     return result;
 }
 
-
-std::shared_ptr<State> RegexToNFA::createState(bool isFinal) {
-    std::set<int> substates{stateCounter++};
-    return std::make_shared<State>(substates, isFinal);
+std::size_t RegexToNFA::createState(bool isFinal) {
+    return pool.create(static_cast<int>(pool.size()), isFinal);
 }
 
-void RegexToNFA::addTransition(TransitionsRelation::TransitionMap& transitions,
-                          const std::shared_ptr<State>& from, char symbol, const std::shared_ptr<State>& to) {
-    TransitionsRelation::TransitionKey key = std::make_pair(from, symbol);
-    auto it = transitions.find(key);
-    if (it != transitions.end()) {
-        if (std::find(it->second.begin(), it->second.end(), to) == it->second.end()) {
-            it->second.push_back(to);
-        }
-    } else {
-        transitions.insert({key, {to}});
-    }
+void RegexToNFA::addTransition(std::size_t from, char symbol, std::size_t to) {
+    edges.push_back({from, symbol, to});
 }
 
-std::unique_ptr<Automaton> RegexToNFA::handleElementaryLanguage(char c) {
-    auto initialState = createState();
-    auto finalState = createState(true);
-    TransitionsRelation::TransitionMap transitions;
-    addTransition(transitions, initialState, c, finalState);
-
-    return std::make_unique<Automaton>(
-        std::make_unique<Alphabet>(std::vector<char>{c}),
-        initialState,
-        std::vector<std::shared_ptr<State>>{initialState, finalState},
-        std::vector<std::shared_ptr<State>>{finalState},
-        transitions
-    );
+RegexToNFA::Fragment RegexToNFA::handleElementaryLanguage(char c) {
+    const std::size_t initialState = createState();
+    const std::size_t finalState = createState(true);
+    addTransition(initialState, c, finalState);
+    return {initialState, finalState};
 }
 
-std::unique_ptr<Automaton> RegexToNFA::handleEmptyWord() {
-    auto state = createState(true);
-    return std::make_unique<Automaton>(
-        std::make_unique<Alphabet>(std::vector<char>{}),
-        state,
-        std::vector<std::shared_ptr<State>>{state},
-        std::vector<std::shared_ptr<State>>{state},
-        TransitionsRelation::TransitionMap()
-    );
+RegexToNFA::Fragment RegexToNFA::handleEmptyWord() {
+    const std::size_t state = createState(true);
+    return {state, state};
 }
 
-std::unique_ptr<Automaton> RegexToNFA::handleDisjunction(std::unique_ptr<Automaton> left, std::unique_ptr<Automaton> right) {
-    auto newInitialState = createState();
-    auto newFinalState = createState(true);
-
-    auto newTransitions = left->getTransitionsRelation()->getTransitions();
-
-    // Add all transitions from right automata
-    for (const auto& [key, value] : right->getTransitionsRelation()->getTransitions()) {
-        for (const auto& toState : value) {
-            addTransition(newTransitions, key.first, key.second, toState);
-        }
-    }
+RegexToNFA::Fragment RegexToNFA::handleDisjunction(Fragment left, Fragment right) {
+    const std::size_t newInitialState = createState();
+    const std::size_t newFinalState = createState(true);
 
     // Connect new initial state to both left and right initial states
-    addTransition(newTransitions, newInitialState, '\0', left->getInitialStateShared());
-    addTransition(newTransitions, newInitialState, '\0', right->getInitialStateShared());
-
-    // Connect all final states to the new final state
-    for (const auto& finalState : left->getFinalStates()) {
-        addTransition(newTransitions, finalState, '\0', newFinalState);
-    }
-    for (const auto& finalState : right->getFinalStates()) {
-        addTransition(newTransitions, finalState, '\0', newFinalState);
-    }
+    addTransition(newInitialState, '\0', left.initialState);
+    addTransition(newInitialState, '\0', right.initialState);
 
-    // Merge states
-    auto newStates = left->getStates();
-    newStates.insert(newStates.end(), right->getStates().begin(), right->getStates().end());
-    newStates.push_back(newInitialState);
-    newStates.push_back(newFinalState);
+    // Connect both final states to the new final state
+    addTransition(left.finalState, '\0', newFinalState);
+    addTransition(right.finalState, '\0', newFinalState);
 
-    // Merge alphabets
-    auto newAlphabet = std::make_unique<Alphabet>(left->_getAlphabet()->_getLetters());
-    auto& newAlphabetLetters = newAlphabet->_getLetters();
-    const auto& rightAlphabetLetters = right->_getAlphabet()->_getLetters();
-    for (char c : rightAlphabetLetters) {
-        if (std::find(newAlphabetLetters.begin(), newAlphabetLetters.end(), c) == newAlphabetLetters.end()) {
-            newAlphabetLetters.push_back(c);
-        }
-    }
-
-    return std::make_unique<Automaton>(
-        std::move(newAlphabet),
-        newInitialState,
-        newStates,
-        std::vector<std::shared_ptr<State>>{newFinalState},
-        newTransitions
-    );
+    return {newInitialState, newFinalState};
 }
 
-std::unique_ptr<Automaton> RegexToNFA::handleConcatenation(std::unique_ptr<Automaton> left, std::unique_ptr<Automaton> right) {
-    auto newTransitions = left->getTransitionsRelation()->getTransitions();
-
-    // Add all transitions from right automata
-    for (const auto& [key, value] : right->getTransitionsRelation()->getTransitions()) {
-        for (const auto& toState : value) {
-            addTransition(newTransitions, key.first, key.second, toState);
-        }
-    }
-
-    // Connect final states of left to initial state of right
-    for (const auto& finalState : left->getFinalStates()) {
-        addTransition(newTransitions, finalState, '\0', right->getInitialStateShared());
-    }
-
-    // Merge states and set new final states
-    auto newStates = left->getStates();
-    newStates.insert(newStates.end(), right->getStates().begin(), right->getStates().end());
-
-    // Merge alphabets
-    auto newAlphabet = std::make_unique<Alphabet>(left->_getAlphabet()->_getLetters());
-    const auto& rightAlphabetLetters = right->_getAlphabet()->_getLetters();
-    for (const char c : rightAlphabetLetters) {
-        if (std::find(newAlphabet->_getLetters().begin(), newAlphabet->_getLetters().end(), c) == newAlphabet->_getLetters().end()) {
-            newAlphabet->_getLetters().push_back(c);
-        }
-    }
-
-    return std::make_unique<Automaton>(
-        std::move(newAlphabet),
-        left->getInitialStateShared(),
-        newStates,
-        right->getFinalStates(),
-        newTransitions
-    );
+RegexToNFA::Fragment RegexToNFA::handleConcatenation(Fragment left, Fragment right) {
+    // Connect final state of left to initial state of right
+    addTransition(left.finalState, '\0', right.initialState);
+    return {left.initialState, right.finalState};
 }
 
-std::unique_ptr<Automaton> RegexToNFA::handleKleeneStar(std::unique_ptr<Automaton> automata) {
-    auto newInitialState = createState();
-    auto newFinalState = createState(true);
-
-    auto newTransitions = automata->getTransitionsRelation()->getTransitions();
+RegexToNFA::Fragment RegexToNFA::handleKleeneStar(Fragment fragment) {
+    const std::size_t newInitialState = createState();
+    const std::size_t newFinalState = createState(true);
 
     // Connect new initial state to new final state and old initial state
-    addTransition(newTransitions, newInitialState, '\0', newFinalState);
-    addTransition(newTransitions, newInitialState, '\0', automata->getInitialStateShared());
+    addTransition(newInitialState, '\0', newFinalState);
+    addTransition(newInitialState, '\0', fragment.initialState);
 
-    // Connect old final states to new final state and old initial state
-    for (const auto& finalState : automata->getFinalStates()) {
-        addTransition(newTransitions, finalState, '\0', newFinalState);
-        addTransition(newTransitions, finalState, '\0', automata->getInitialStateShared());
-    }
-
-    // Add new states
-    auto newStates = automata->getStates();
-    newStates.push_back(newInitialState);
-    newStates.push_back(newFinalState);
+    // Connect old final state to new final state and old initial state
+    addTransition(fragment.finalState, '\0', newFinalState);
+    addTransition(fragment.finalState, '\0', fragment.initialState);
 
-    return std::make_unique<Automaton>(
-        std::make_unique<Alphabet>(automata->_getAlphabet()->_getLetters()),
-        newInitialState,
-        newStates,
-        std::vector<std::shared_ptr<State>>{newFinalState},
-        newTransitions
-    );
+    return {newInitialState, newFinalState};
 }
 
-std::set<std::shared_ptr<State>> RegexToNFA::findEpsilonClosure(
-    const std::shared_ptr<State>& state,
-    const TransitionsRelation::TransitionMap& transitions) {
-    std::set<std::shared_ptr<State>> closure;
-    std::stack<std::shared_ptr<State>> stack;
-    stack.push(state);
-
-    while (!stack.empty()) {
-        auto currentState = stack.top();
-        stack.pop();
+// The only place where shared pointers and the transition map are created
+std::unique_ptr<Automaton> RegexToNFA::materialize(Fragment fragment) {
+    std::vector<std::shared_ptr<State>> states = pool.share();
 
-        if (closure.find(currentState) != closure.end()) continue;
-        closure.insert(currentState);
-
-        for (const auto& [key, value] : transitions) {
-            if (key.first == currentState && key.second == '\0') {
-                for (const auto& nextState : value) {
-                    if (closure.find(nextState) == closure.end()) {
-                        stack.push(nextState);
-                    }
-                }
-            }
+    TransitionsRelation::TransitionMap transitions;
+    std::vector<char> letters;
+    for (const auto& edge : edges) {
+        auto& targets = transitions[{states[edge.from], edge.symbol}];
+        if (std::find(targets.begin(), targets.end(), states[edge.to]) == targets.end()) {
+            targets.push_back(states[edge.to]);
         }
-    }
-
-    return closure;
-}
-
-void RegexToNFA::buildNewTransitions(
-    const TransitionsRelation::TransitionMap& oldTransitions,
-    TransitionsRelation::TransitionMap& newTransitions,
-    const std::vector<std::shared_ptr<State>>& states) {
-    for (const auto& state : states) {
-        auto closure = findEpsilonClosure(state, oldTransitions);
-
-        for (const auto& closureState : closure) {
-            for (const auto& [key, value] : oldTransitions) {
-                if (key.first == closureState && key.second != '\0') {
-                    for (const auto& reachableState : value) {
-                        addTransition(newTransitions, state, key.second, reachableState);
-                    }
-                }
-            }
+        // symbol edges are created in pattern order, so letters keep the order of their first occurrence
+        if (edge.symbol != '\0' && std::find(letters.begin(), letters.end(), edge.symbol) == letters.end()) {
+            letters.push_back(edge.symbol);
         }
     }
-}
-
-std::set<std::shared_ptr<State>> RegexToNFA::findReachableStates(
-    const std::shared_ptr<State>& initialState,
-    const TransitionsRelation::TransitionMap& transitions) {
-    std::set<std::shared_ptr<State>> reachableStates;
-    std::stack<std::shared_ptr<State>> stack;
-    stack.push(initialState);
-
-    while (!stack.empty()) {
-        auto state = stack.top();
-        stack.pop();
-
-        if (reachableStates.find(state) != reachableStates.end()) continue;
-        reachableStates.insert(state);
+    edges.clear();
 
-        for (const auto& [key, value] : transitions) {
-            if (key.first == state) {
-                for (const auto& nextState : value) {
-                    if (reachableStates.find(nextState) == reachableStates.end()) {
-                        stack.push(nextState);
-                    }
-                }
-            }
-        }
-    }
-
-    return reachableStates;
+    auto initialState = states[fragment.initialState];
+    auto finalState = states[fragment.finalState];
+    return std::make_unique<Automaton>(std::make_unique<Alphabet>(letters), initialState, std::move(states),
+                                       std::vector<std::shared_ptr<State>>{finalState}, std::move(transitions));
 }
 
 // Remove epsilon transitions and compute direct character transitions
 void RegexToNFA::removeEpsilonTransitions(std::unique_ptr<Automaton>& automata)
 {
-    // Get current transitions, states, initial and final states
-    auto oldTransitions = automata->getTransitionsRelation()->getTransitions();
-    auto states = automata->getStates();
-    auto initialState = automata->getInitialStateShared();
-    auto finalStates = automata->getFinalStates();
-
-    // New transition map after removing epsilon transitions
-    TransitionsRelation::TransitionMap newTransitions;
-
-    // Build transitions for each state considering epsilon closures
-    buildNewTransitions(oldTransitions, newTransitions, states);
-
-    // Find new final states by checking if any state in its epsilon closure is a final state
-    std::set<std::shared_ptr<State>> newFinalStates;
-    for (const auto& state : states) {
-        auto closure = findEpsilonClosure(state, oldTransitions);
-        for (const auto& closureState : closure) {
-            if (std::find(finalStates.begin(), finalStates.end(), closureState) != finalStates.end()) {
-                newFinalStates.insert(state); // Current state becomes final if any closure state is final
-                break;
-            }
-        }
-    }
-
-    // Find all reachable states from the initial state
-    auto reachableStates = findReachableStates(initialState, newTransitions);
-
-    // Filter out unreachable transitions and states
-    TransitionsRelation::TransitionMap finalTransitions;
-    for (const auto& [key, value] : newTransitions) {
-        if (reachableStates.find(key.first) != reachableStates.end()) {
-            std::vector<std::shared_ptr<State>> reachableTargets;
-            for (const auto& target : value) {
-                if (reachableStates.find(target) != reachableStates.end()) {
-                    reachableTargets.push_back(target); // Add only reachable target states
-                }
-            }
-            if (!reachableTargets.empty()) {
-                finalTransitions[key] = reachableTargets; // Update final transitions map
-            }
-        }
-    }
-
-    // Collect reachable final states
-    std::vector<std::shared_ptr<State>> finalStatesList;
-    for (const auto& state : newFinalStates) {
-        if (reachableStates.find(state) != reachableStates.end()) {
-            finalStatesList.push_back(state); // Only include reachable final states
-        }
-    }
-
-    // Update the automata with new transitions, states, and final states
-    automata->_getTransitionsRelation()->setTransitions(finalTransitions);
-    automata->setStates(std::vector<std::shared_ptr<State>>(reachableStates.begin(), reachableStates.end()));
-    automata->setFinalStates(finalStatesList);
+    EpsilonRemover(*automata).apply(*automata);
 }
 
 
 std::unique_ptr<Automaton> RegexToNFA::convert() {
-    return parseExpression();
+    auto syntaxTree = RegexParser(regex).parse();
+    if (engine == Engine::Glushkov) {
+        return GlushkovBuilder().build(*syntaxTree);
+    }
+
+    return materialize(buildThompson(*syntaxTree));
 }
\ No newline at end of file
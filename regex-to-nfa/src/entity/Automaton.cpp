@@ -128,6 +128,12 @@ const std::vector<std::shared_ptr<State>>& Automaton::getStates() const
     return states;
 }
 
+std::vector<std::shared_ptr<State>>& Automaton::_getStates()
+{
+    transitionsRelation->unfreeze(); // state ids follow the order of states
+    return states;
+}
+
 const std::vector<std::shared_ptr<State>>& Automaton::getFinalStates() const
 {
     return finalStates;
@@ -157,6 +163,7 @@ void Automaton::setInitialState(std::shared_ptr<State> newInitialState)
 void Automaton::setStates(const std::vector<std::shared_ptr<State>>& newStates)
 {
     states = newStates;
+    transitionsRelation->unfreeze(); // state ids follow the order of states
 }
 
 void Automaton::setFinalStates(const std::vector<std::shared_ptr<State>>& newFinalStates)
@@ -177,7 +184,7 @@ std::shared_ptr<State> Automaton::findStateBySubstates(const std::set<int>& subs
 {
     for (const std::shared_ptr<State>& s : states)
     {
-        if (substates == s->getSubstates())
+        if (s->getSubstateSet() == substates)
         {
             return s;
         }
@@ -185,16 +192,27 @@ std::shared_ptr<State> Automaton::findStateBySubstates(const std::set<int>& subs
     return std::shared_ptr<State>{};
 }
 
+const FrozenTransitions& Automaton::freeze() const
+{
+    return transitionsRelation->freeze(states);
+}
+
 /**
  * Check if each transition has maximum 1 end state
  */
 bool Automaton::isDeterministic() const
 {
-    for (const auto& [key, nextStates] : this->transitionsRelation->getTransitions())
+    const FrozenTransitions& frozen = freeze();
+    for (FrozenTransitions::StateId state = 0; state < frozen.stateCount(); ++state)
     {
-        if (nextStates.size() > 1)
+        // edges are sorted by symbol, so two edges on the same symbol are neighbours
+        const auto row = frozen.edges(state);
+        for (const auto* edge = row.begin(); edge != row.end(); ++edge)
         {
-            return false;
+            if (edge + 1 != row.end() && (edge + 1)->symbol == edge->symbol)
+            {
+                return false;
+            }
         }
     }
     return true;
@@ -5,7 +5,7 @@
 std::shared_ptr<State> AutomatonBuilder::getState(int stateId) {
     auto it = stateMap.find(stateId);
     if (it == stateMap.end()) {
-        auto state = std::make_shared<State>(std::set<int>{stateId});
+        auto state = std::make_shared<State>(stateId);
         stateMap[stateId] = state;
         return state;
     }
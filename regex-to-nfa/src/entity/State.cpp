@@ -1,6 +1,6 @@
 #include <entity/State.h>
 
-std::string State::implode(const std::vector<int>& elements, char delimiter)
+std::string State::implode(const SubstateSet& elements, char delimiter)
 {
     if (elements.empty())
     {
@@ -8,18 +8,41 @@ std::string State::implode(const std::vector<int>& elements, char delimiter)
     }
 
     std::string result;
-    result += std::to_string(elements[0]);
+    result += std::to_string(*elements.begin());
 
-    for (size_t i = 1; i < elements.size(); ++i)
+    for (const int* it = elements.begin() + 1; it != elements.end(); ++it)
     {
         result += delimiter;
-        result += std::to_string(elements[i]);
+        result += std::to_string(*it);
     }
     return result;
 }
 
-State::State(std::set<int> substates, bool final)
-    : substates(std::move(substates)), final(final)
+std::size_t State::hashSubstates(const SubstateSet& elements)
+{
+    size_t hashValue = 0;
+    for (int element : elements)
+    {
+        hashValue ^= std::hash<int>{}(element) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+    }
+    return hashValue;
+}
+
+State::State(const std::set<int>& substates, bool final)
+    : substates(substates), final(final), substateHash(hashSubstates(this->substates)),
+      name(implode(this->substates, ','))
+{
+}
+
+State::State(SubstateSet substates, bool final)
+    : substates(std::move(substates)), final(final), substateHash(hashSubstates(this->substates)),
+      name(implode(this->substates, ','))
+{
+}
+
+State::State(int substate, bool final)
+    : substates(substate), final(final), substateHash(hashSubstates(this->substates)),
+      name(implode(this->substates, ','))
 {
 }
 
@@ -33,9 +56,14 @@ void State::setFinal(bool final)
     this->final = final;
 }
 
-std::string State::getName() const
+const std::string& State::getName() const
+{
+    return name;
+}
+
+std::size_t State::getHash() const
 {
-    return implode(std::vector<int>(this->substates.begin(), this->substates.end()), ',');
+    return substateHash;
 }
 
 /**
@@ -48,10 +76,17 @@ bool State::isAtomic() const
 
 void State::setSubstates(const std::set<int>& newSubstates)
 {
-    this->substates = newSubstates;
+    this->substates = SubstateSet(newSubstates);
+    this->substateHash = hashSubstates(this->substates);
+    this->name = implode(this->substates, ',');
 }
 
 const std::set<int> State::getSubstates() const
+{
+    return this->substates.toSet();
+}
+
+const SubstateSet& State::getSubstateSet() const
 {
     return this->substates;
 }
@@ -65,11 +100,7 @@ namespace std
 {
     size_t hash<State>::operator()(const State& state) const
     {
-        size_t hashValue = 0;
-        for (char c : state.getName())
-        {
-            hashValue ^= std::hash<char>{}(c) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
-        }
+        size_t hashValue = state.getHash();
         hashValue ^= std::hash<bool>{}(state.isFinal());
         return hashValue;
     }
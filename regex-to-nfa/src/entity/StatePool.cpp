@@ -0,0 +1,32 @@
+#include <entity/StatePool.h>
+#include <utility>
+
+std::size_t StatePool::create(int substate, bool final)
+{
+    states.emplace_back(substate, final);
+    return states.size() - 1;
+}
+
+std::size_t StatePool::size() const
+{
+    return states.size();
+}
+
+const State& StatePool::operator[](std::size_t index) const
+{
+    return states[index];
+}
+
+std::vector<std::shared_ptr<State>> StatePool::share()
+{
+    auto block = std::make_shared<std::vector<State>>(std::move(states));
+    states.clear();
+
+    std::vector<std::shared_ptr<State>> shared;
+    shared.reserve(block->size());
+    for (State& state : *block)
+    {
+        shared.emplace_back(block, &state);
+    }
+    return shared;
+}
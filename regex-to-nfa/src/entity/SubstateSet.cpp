@@ -0,0 +1,69 @@
+#include <entity/SubstateSet.h>
+#include <algorithm>
+
+SubstateSet::SubstateSet(int substate)
+    : count(1)
+{
+    inlineItems[0] = substate;
+}
+
+SubstateSet::SubstateSet(const std::set<int>& substates)
+    : SubstateSet(std::vector<int>(substates.begin(), substates.end()))
+{
+}
+
+SubstateSet::SubstateSet(std::vector<int> substates)
+{
+    std::sort(substates.begin(), substates.end());
+    substates.erase(std::unique(substates.begin(), substates.end()), substates.end());
+
+    count = static_cast<std::uint32_t>(substates.size());
+    if (count <= inlineCapacity)
+    {
+        std::copy(substates.begin(), substates.end(), inlineItems);
+    }
+    else
+    {
+        overflow = std::move(substates);
+    }
+}
+
+const int* SubstateSet::begin() const
+{
+    return count <= inlineCapacity ? inlineItems : overflow.data();
+}
+
+const int* SubstateSet::end() const
+{
+    return begin() + count;
+}
+
+std::size_t SubstateSet::size() const
+{
+    return count;
+}
+
+bool SubstateSet::empty() const
+{
+    return count == 0;
+}
+
+std::set<int> SubstateSet::toSet() const
+{
+    return {begin(), end()};
+}
+
+bool SubstateSet::operator==(const SubstateSet& other) const
+{
+    return std::equal(begin(), end(), other.begin(), other.end());
+}
+
+bool SubstateSet::operator!=(const SubstateSet& other) const
+{
+    return !(*this == other);
+}
+
+bool SubstateSet::operator==(const std::set<int>& other) const
+{
+    return std::equal(begin(), end(), other.begin(), other.end());
+}
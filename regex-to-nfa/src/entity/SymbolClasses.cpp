@@ -0,0 +1,83 @@
+#include <entity/SymbolClasses.h>
+#include <map>
+#include <utility>
+
+SymbolClasses::SymbolClasses(const FrozenTransitions& frozen)
+{
+    // Signature of a symbol: all its (source, target) edges, rows are visited in order and sorted by target,
+    // so equal behaviour gives equal vectors
+    std::array<std::vector<std::pair<StateId, StateId>>, 256> signatures;
+    for (StateId state = 0; state < frozen.stateCount(); ++state)
+    {
+        for (const auto& edge : frozen.edges(state))
+        {
+            if (edge.symbol == '\0') continue;
+            signatures[static_cast<unsigned char>(edge.symbol)].emplace_back(state, edge.target);
+        }
+    }
+
+    std::map<std::vector<std::pair<StateId, StateId>>, ClassId> classIds;
+    members.emplace_back();
+    for (std::size_t byte = 0; byte < 256; ++byte)
+    {
+        const char symbol = static_cast<char>(byte);
+        if (signatures[byte].empty())
+        {
+            members[0].push_back(symbol);
+            continue;
+        }
+
+        auto [it, inserted] = classIds.emplace(std::move(signatures[byte]), static_cast<ClassId>(members.size()));
+        if (inserted)
+        {
+            members.emplace_back();
+        }
+        table[byte] = it->second;
+        members[it->second].push_back(symbol);
+    }
+
+    // Only the smallest symbol of a class keeps its edges, rows stay sorted as class ids follow that symbol
+    offsets.assign(frozen.stateCount() + 1, 0);
+    for (StateId state = 0; state < frozen.stateCount(); ++state)
+    {
+        for (const auto& edge : frozen.edges(state))
+        {
+            const ClassId symbolClass = classOf(edge.symbol);
+            if (symbolClass != 0 && members[symbolClass].front() == edge.symbol)
+            {
+                transitions.push_back(Edge{symbolClass, edge.target});
+            }
+        }
+        offsets[state + 1] = static_cast<std::uint32_t>(transitions.size());
+    }
+}
+
+std::size_t SymbolClasses::classCount() const
+{
+    return members.size();
+}
+
+SymbolClasses::ClassId SymbolClasses::classOf(char symbol) const
+{
+    return table[static_cast<unsigned char>(symbol)];
+}
+
+const std::array<SymbolClasses::ClassId, 256>& SymbolClasses::getTable() const
+{
+    return table;
+}
+
+const std::vector<char>& SymbolClasses::getMembers(ClassId symbolClass) const
+{
+    return members.at(symbolClass);
+}
+
+const SymbolClasses::Edge* SymbolClasses::begin(StateId state) const
+{
+    return transitions.data() + offsets[state];
+}
+
+const SymbolClasses::Edge* SymbolClasses::end(StateId state) const
+{
+    return transitions.data() + offsets[state + 1];
+}
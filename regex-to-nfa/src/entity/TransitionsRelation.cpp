@@ -1,16 +1,14 @@
 #include <entity/TransitionsRelation.h>
+#include <stdexcept>
 #include <utility>
 
-template <class T1, class T2>
-size_t PairHash::operator()(const std::pair<std::shared_ptr<T1>, T2>& p) const
+TransitionsRelation::TransitionsRelation(TransitionMap transitions)
+    : transitions(std::move(transitions))
 {
-    auto hash1 = std::hash<std::shared_ptr<T1>>{}(p.first);
-    auto hash2 = std::hash<T2>{}(p.second);
-    return hash1 ^ (hash2 << 1); // Combine the two hash values
 }
 
-TransitionsRelation::TransitionsRelation(TransitionMap transitions)
-    : transitions(std::move(transitions))
+TransitionsRelation::TransitionsRelation(const TransitionsRelation& other)
+    : transitions(other.transitions)
 {
 }
 
@@ -25,17 +23,33 @@ std::vector<std::shared_ptr<State>> TransitionsRelation::move(const std::shared_
     return {}; // Return an empty vector if no transition exists
 }
 
+FrozenTransitions::EdgeRange TransitionsRelation::move(FrozenTransitions::StateId current, char input) const
+{
+    if (!frozen)
+    {
+        throw std::logic_error("Transitions relation is not frozen");
+    }
+    return frozen->move(current, input);
+}
+
 [[nodiscard]] const TransitionsRelation::TransitionMap& TransitionsRelation::getTransitions() const
 {
     return transitions;
 }
 
+TransitionsRelation::TransitionMap& TransitionsRelation::_getTransitions()
+{
+    frozen.reset();
+    return transitions;
+}
+
 /*
     Inserts new mapping (startState, input) -> endState, if it didn't exist.
 */
 void TransitionsRelation::addTransition(const std::shared_ptr<State>& startState, char input,
                                         const std::shared_ptr<State>& endState)
 {
+    frozen.reset();
     TransitionKey key = std::make_pair(startState, input);
 
     auto search = transitions.find(key); // pair (key,vector<shared_ptr<State>>)
@@ -45,7 +59,7 @@ void TransitionsRelation::addTransition(const std::shared_ptr<State>& startState
         for (const auto& s : search->second)
         {
             // check if transition with same endState is already here
-            if (s->getSubstates() == endState->getSubstates())
+            if (s->getSubstateSet() == endState->getSubstateSet())
             {
                 return; // no actions required, because desired transition is already here
             }
@@ -61,5 +75,25 @@ void TransitionsRelation::addTransition(const std::shared_ptr<State>& startState
 
 void TransitionsRelation::setTransitions(const TransitionMap& pairs)
 {
+    frozen.reset();
     transitions = pairs;
 }
+
+const FrozenTransitions& TransitionsRelation::freeze(const std::vector<std::shared_ptr<State>>& states) const
+{
+    if (!frozen || !frozen->isBuiltFor(states))
+    {
+        frozen = std::make_unique<const FrozenTransitions>(states, transitions);
+    }
+    return *frozen;
+}
+
+const FrozenTransitions* TransitionsRelation::getFrozen() const
+{
+    return frozen.get();
+}
+
+void TransitionsRelation::unfreeze()
+{
+    frozen.reset();
+}
@@ -1,15 +1,23 @@
+#include <algorithm>
 #include <iostream>
+#include <set>
+#include <algo/BitParallelMatcher.h>
+#include <algo/DFAMinimizer.h>
+#include <algo/Determinizer.h>
 #include <algo/RegexToNFA.h>
 #include <helper/SynthesisHelper.h>
 #include <helper/VisualizeHelper.h>
 
-std::unique_ptr<Automaton> SynthesisHelper::getNFA(const std::string& regex, bool print)
+std::unique_ptr<Automaton> SynthesisHelper::getNFA(const std::string& regex, bool print, RegexToNFA::Engine engine)
 {
-    RegexToNFA converter(regex);
+    RegexToNFA converter(regex, engine);
     std::unique_ptr<Automaton> nfa = converter.convert();
 
     if (print) nfa->print();
 
+    // Glushkov automata have no epsilon transitions to remove
+    if (engine == RegexToNFA::Engine::Glushkov) return nfa;
+
     RegexToNFA::removeEpsilonTransitions(nfa);
 
     if (print)
@@ -21,14 +29,30 @@ std::unique_ptr<Automaton> SynthesisHelper::getNFA(const std::string& regex, boo
     return nfa;
 }
 
+std::unique_ptr<Automaton> SynthesisHelper::getDFA(const std::string& regex, bool print)
+{
+    std::unique_ptr<Automaton> nfa = getNFA(regex);
+    std::unique_ptr<Automaton> dfa = Determinizer(*nfa).determinize();
+
+    if (print) dfa->print();
+
+    return dfa;
+}
+
+std::unique_ptr<Automaton> SynthesisHelper::getMinimalDFA(const std::string& regex, bool print)
+{
+    std::unique_ptr<Automaton> dfa = getDFA(regex);
+    std::unique_ptr<Automaton> minimal = DFAMinimizer(*dfa).minimize();
+
+    if (print) minimal->print();
+
+    return minimal;
+}
+
 void SynthesisHelper::examples()
 {
     std::cout << "\n|------------------------------ START: Synthesis Example -----------------------------|\n";
-    std::string regex1 = "(x|y)*x|x*y*";
-    std::string regex2 = "((0)*1)*";
-    std::string regex3 = "xy*|y|yx|xx";
-
-    std::vector<std::string> regex = {regex1, regex2, regex3};
+    std::vector<std::string> regex = exampleRegexes();
 
     for (int i = 0; i < regex.size(); i++)
     {
@@ -41,4 +65,138 @@ void SynthesisHelper::examples()
     }
 
     std::cout << "\n|------------------------------ END: Synthesis Example -----------------------------|\n";
+
+    determinizationExamples();
+    engineExamples();
+    matcherExamples();
+}
+
+void SynthesisHelper::determinizationExamples()
+{
+    std::cout << "\n|------------------------------ Determinization Examples -----------------------------|\n";
+    for (const std::string& regex : exampleRegexes())
+    {
+        auto nfa = getNFA(regex);
+        auto dfa = getDFA(regex);
+        auto minimal = getMinimalDFA(regex);
+
+        std::size_t words = 0;
+        std::size_t disagreements = 0;
+        for (const std::string& word : wordsUpTo(nfa->getAlphabet()->getLetters(), 6))
+        {
+            ++words;
+            const bool expected = accepts(*nfa, word);
+            if (accepts(*dfa, word) != expected || accepts(*minimal, word) != expected)
+            {
+                ++disagreements;
+                std::cout << "  differ on '" << word << "'\n";
+            }
+        }
+        std::cout << "Regex: " << regex << ", NFA states: " << nfa->getStates().size()
+                  << ", DFA states: " << dfa->getStates().size()
+                  << ", minimal DFA states: " << minimal->getStates().size()
+                  << ", disagreements on " << words << " words: " << disagreements << '\n';
+    }
+}
+
+void SynthesisHelper::engineExamples()
+{
+    std::cout << "\n|------------------------------ Thompson vs Glushkov -----------------------------|\n";
+    for (const std::string& regex : exampleRegexes())
+    {
+        auto thompson = getNFA(regex);
+        auto glushkov = getNFA(regex, false, RegexToNFA::Engine::Glushkov);
+
+        std::size_t words = 0;
+        std::size_t disagreements = 0;
+        for (const std::string& word : wordsUpTo(thompson->getAlphabet()->getLetters(), 6))
+        {
+            ++words;
+            if (accepts(*thompson, word) != accepts(*glushkov, word))
+            {
+                ++disagreements;
+                std::cout << "  differ on '" << word << "'\n";
+            }
+        }
+        std::cout << "Regex: " << regex << ", Thompson states: " << thompson->getStates().size()
+                  << ", Glushkov states: " << glushkov->getStates().size()
+                  << ", disagreements on " << words << " words: " << disagreements << '\n';
+    }
+}
+
+void SynthesisHelper::matcherExamples()
+{
+    std::cout << "\n|------------------------------ Bit-Parallel Matching -----------------------------|\n";
+    for (const std::string& regex : exampleRegexes())
+    {
+        auto nfa = getNFA(regex);
+        const BitParallelMatcher matcher(*nfa);
+
+        std::size_t words = 0;
+        std::size_t matched = 0;
+        std::size_t disagreements = 0;
+        for (const std::string& word : wordsUpTo(nfa->getAlphabet()->getLetters(), 6))
+        {
+            ++words;
+            const bool expected = accepts(*nfa, word);
+            matched += expected;
+            if (matcher.matches(word) != expected)
+            {
+                ++disagreements;
+                std::cout << "  differ on '" << word << "'\n";
+            }
+        }
+        std::cout << "Regex: " << regex << ", positions: " << matcher.positionCount()
+                  << ", accepted " << matched << " of " << words << " words, disagreements: "
+                  << disagreements << '\n';
+    }
+}
+
+std::vector<std::string> SynthesisHelper::exampleRegexes()
+{
+    std::string regex1 = "(x|y)*x|x*y*";
+    std::string regex2 = "((0)*1)*";
+    std::string regex3 = "xy*|y|yx|xx";
+
+    return {regex1, regex2, regex3};
+}
+
+bool SynthesisHelper::accepts(const Automaton& automaton, const std::string& word)
+{
+    std::set<std::shared_ptr<State>> current = {automaton.getInitialStateShared()};
+    for (char symbol : word)
+    {
+        std::set<std::shared_ptr<State>> next;
+        for (const auto& state : current)
+        {
+            for (const auto& target : automaton.getTransitionsRelation()->move(state, symbol))
+            {
+                next.insert(target);
+            }
+        }
+        current = std::move(next);
+    }
+
+    const auto& finalStates = automaton.getFinalStates();
+    return std::any_of(current.begin(), current.end(), [&finalStates](const std::shared_ptr<State>& state) {
+        return std::find(finalStates.begin(), finalStates.end(), state) != finalStates.end();
+    });
+}
+
+// All words over the letters up to the given length, shortest first
+std::vector<std::string> SynthesisHelper::wordsUpTo(const std::vector<char>& letters, std::size_t length)
+{
+    std::vector<std::string> words = {""};
+    for (std::size_t begin = 0; begin < words.size(); ++begin)
+    {
+        if (words[begin].size() == length)
+        {
+            break;
+        }
+        for (char letter : letters)
+        {
+            words.push_back(words[begin] + letter);
+        }
+    }
+    return words;
 }